@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "arena.hh"
+
+const size_t Arena::BLOCK_SIZE;
+const size_t Arena::LARGE;
+const size_t Arena::KEEP_BLOCKS;
+
+
+
+Arena::Arena() {
+  _current = 0;
+  _used = 0;
+  _mallocs = 0;
+  _allocations = 0;
+  _lineAllocations = 0;
+  _resets = 0;
+}
+
+Arena::~Arena() {
+  for (auto & block : _blocks) {
+    free(block.data);
+  }
+  for (auto & block : _large) {
+    free(block.data);
+  }
+}
+
+
+
+static void *mallocOrDie(size_t size) {
+  void *p = malloc(size);
+  if (p == NULL) {
+    perror("malloc");
+    exit(1);
+  }
+  return p;
+}
+
+
+
+void *Arena::allocate(size_t size, size_t align) {
+
+  _allocations++;
+  _lineAllocations++;
+
+  // Big: a malloc of its own (aligned for anything), release() or reset() frees it
+  if (size > LARGE) {
+    Block block;
+    block.size = size;
+    block.data = (char *) mallocOrDie(size);
+    _mallocs++;
+    _large.push_back(block);
+    return block.data;
+  }
+
+  // Fits in the current block?
+  if (_current < _blocks.size()) {
+    size_t start = (_used + align - 1) & ~(align - 1);
+    if (start + size <= _blocks[_current].size) {
+      _used = start + size;
+      return _blocks[_current].data + start;
+    }
+  }
+
+  // Next kept block (blocks come from malloc, so they are aligned for
+  // anything, and every one is BLOCK_SIZE)
+  if (_current + 1 < _blocks.size()) {
+    _current++;
+    _used = size;
+    return _blocks[_current].data;
+  }
+
+  // Need a new block
+  Block block;
+  block.size = BLOCK_SIZE;
+  block.data = (char *) mallocOrDie(block.size);
+  _mallocs++;
+
+  _blocks.push_back(block);
+  _current = _blocks.size() - 1;
+  _used = size;
+  return block.data;
+}
+
+
+
+char *Arena::strdup(const char *s, size_t length) {
+  char *copy = (char *) allocate(length + 1, 1);
+  memcpy(copy, s, length);
+  copy[length] = '\0';
+  return copy;
+}
+
+
+
+void Arena::release(void *p, size_t size) {
+  if (size <= LARGE) {
+    return;
+  }
+  // Newest first, a growing vector frees the one it just outgrew
+  for (size_t i = _large.size(); i-- > 0; ) {
+    if (_large[i].data == p) {
+      free(p);
+      _large[i] = _large.back();
+      _large.pop_back();
+      return;
+    }
+  }
+}
+
+
+
+void Arena::reset() {
+  for (auto & block : _large) {
+    free(block.data);
+  }
+  _large.clear();
+
+  // A huge command made lots of blocks, don't keep them all
+  while (_blocks.size() > KEEP_BLOCKS) {
+    free(_blocks.back().data);
+    _blocks.pop_back();
+  }
+
+  _current = 0;
+  _used = 0;
+  _lineAllocations = 0;
+  _resets++;
+}
+
+
+
+void Arena::printStats() {
+  size_t bytes = 0;
+  for (auto & block : _blocks) {
+    bytes += block.size;
+  }
+  size_t largeBytes = 0;
+  for (auto & block : _large) {
+    largeBytes += block.size;
+  }
+  printf("blocks:       %zu (%zu bytes)\n", _blocks.size(), bytes);
+  printf("large:        %zu (%zu bytes)\n", _large.size(), largeBytes);
+  printf("mallocs:      %zu\n", _mallocs);
+  printf("allocations:  %zu (%zu this line)\n", _allocations, _lineAllocations);
+  printf("resets:       %zu\n", _resets);
+}
@@ -0,0 +1,103 @@
+#ifndef arena_hh
+#define arena_hh
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+
+
+/* Bump allocator for everything one command line needs:
+ * lexer tokens, SimpleCommands, their argument buffers, redirect file names.
+ * Nothing is freed one by one, reset() throws everything away at once
+ * (Command::clear()). A few blocks are kept for the next command, so once
+ * the shell has warmed up a repeated command doesn't malloc at all.
+ * Big requests (a vector of 2M arguments growing...) get a malloc of their
+ * own that goes back to malloc when the vector lets go of it, or at the
+ * latest on reset(). One huge command doesn't leave the shell huge.
+ */
+struct Arena {
+
+  // One chunk of memory from malloc
+  struct Block {
+    char *data;
+    size_t size;
+  };
+
+  static const size_t BLOCK_SIZE = 64 * 1024;
+  static const size_t LARGE = BLOCK_SIZE / 4; // bigger requests get their own malloc
+  static const size_t KEEP_BLOCKS = 4;        // blocks reset() keeps
+
+  std::vector<Block> _blocks;
+  size_t _current; // block we are allocating from
+  size_t _used;    // bytes used in the current block
+
+  std::vector<Block> _large; // the big requests still in use
+
+  // Counters ('arenastat' builtin)
+  size_t _mallocs;        // blocks ever taken from malloc
+  size_t _allocations;    // allocate() calls since the shell started
+  size_t _lineAllocations; // allocate() calls since the last reset
+  size_t _resets;
+
+  Arena();
+  ~Arena();
+
+  void *allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+  // Give memory back early. Only big requests are really freed, the rest
+  // waits for reset()
+  void release(void *p, size_t size);
+
+  // Copy a string into the arena (NUL terminated)
+  char *strdup(const char *s, size_t length);
+  char *strdup(const char *s) { return strdup(s, strlen(s)); }
+  char *strdup(const std::string &s) { return strdup(s.c_str(), s.size()); }
+
+  // new T(args...) in the arena. The destructor is never called by the
+  // arena, only use it for types that don't own heap memory.
+  template <class T, class... Args>
+  T *create(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(static_cast<Args&&>(args)...);
+  }
+
+  // Forget everything allocated, keep the first KEEP_BLOCKS blocks
+  void reset();
+
+  void printStats();
+};
+
+
+
+// Allocator so std::vector can grow inside an arena.
+// Small buffers come back on Arena::reset(), big ones as soon as the vector
+// moves to a bigger one
+template <class T>
+struct ArenaAllocator {
+  typedef T value_type;
+
+  Arena *_arena;
+
+  ArenaAllocator(Arena *arena) : _arena(arena) {}
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other._arena) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    _arena->release(p, n * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U> &other) const { return _arena == other._arena; }
+
+  template <class U>
+  bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other._arena; }
+};
+
+#endif
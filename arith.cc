@@ -0,0 +1,506 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <unordered_map>
+
+#include "arith.hh"
+#include "variables.hh"
+
+
+
+// Operators. Two char ones are packed as c1 * 256 + c2, three char ones (<<= >>=) get their own
+enum {
+  NUMBER = 1, VARIABLE, END,
+  POSTINC, POSTDEC, PREINC, PREDEC, NEGATE, PLUS, NOT, COMPLEMENT,
+  SHL_ASSIGN, SHR_ASSIGN
+};
+
+#define OP2(a, b) ((a) * 256 + (b))
+
+
+
+/* Recursive descent parser, one function per precedence level
+ *   ,   = op=   ?:   ||   &&   |   ^   &   == !=   < > <= >=   << >>
+ *   + -   * / %   **   unary + - ! ~ ++ --   postfix ++ --   ( ) numbers names
+ */
+struct ArithParser {
+
+  const char *p;
+  const char *end;
+  ArithExpression &expr;
+  bool error;
+
+  ArithParser(const char *text, size_t length, ArithExpression &e)
+    : p(text), end(text + length), expr(e), error(false) {}
+
+  int node(int op, int a = -1, int b = -1, int c = -1) {
+    ArithNode n;
+    n.op = op;
+    n.value = 0;
+    n.a = a;
+    n.b = b;
+    n.c = c;
+    expr._nodes.push_back(n);
+    return expr._nodes.size() - 1;
+  }
+
+  void skipSpaces() {
+    while (p < end && isspace((unsigned char) *p)) {
+      p++;
+    }
+  }
+
+  // Length of the operator at p, longest one wins like in C (<<= before << before <)
+  size_t operatorLength() {
+    static const char *ops[] = {
+      "<<=", ">>=",
+      "**", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||", "++", "--",
+      "*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=",
+    };
+    for (const char *op : ops) {
+      size_t n = strlen(op);
+      if ((size_t) (end - p) >= n && memcmp(p, op, n) == 0) {
+        return n;
+      }
+    }
+    return p < end ? 1 : 0;
+  }
+
+  bool peek(const char *op) {
+    skipSpaces();
+    size_t n = strlen(op);
+    return operatorLength() == n && memcmp(p, op, n) == 0;
+  }
+
+  bool accept(const char *op) {
+    if (peek(op)) {
+      p += strlen(op);
+      return true;
+    }
+    return false;
+  }
+
+  int comma() {
+    int left = assignment();
+    while (!error && accept(",")) {
+      left = node(',', left, assignment());
+    }
+    return left;
+  }
+
+  int assignment() {
+    int left = ternary();
+    if (error) {
+      return left;
+    }
+
+    static const struct { const char *text; int op; } ops[] = {
+      { "<<=", SHL_ASSIGN }, { ">>=", SHR_ASSIGN },
+      { "*=", OP2('*', '=') }, { "/=", OP2('/', '=') }, { "%=", OP2('%', '=') },
+      { "+=", OP2('+', '=') }, { "-=", OP2('-', '=') }, { "&=", OP2('&', '=') },
+      { "^=", OP2('^', '=') }, { "|=", OP2('|', '=') }, { "=", '=' },
+    };
+    for (auto & op : ops) {
+      if (accept(op.text)) {
+        if (expr._nodes[left].op != VARIABLE) {
+          error = true;
+          return left;
+        }
+        int right = assignment(); // right to left
+        int n = node(op.op, right);
+        expr._nodes[n].name = expr._nodes[left].name;
+        return n;
+      }
+    }
+    return left;
+  }
+
+  int ternary() {
+    int cond = logicalOr();
+    if (!error && accept("?")) {
+      int yes = comma();
+      if (!accept(":")) {
+        error = true;
+        return cond;
+      }
+      int no = ternary();
+      return node('?', cond, yes, no);
+    }
+    return cond;
+  }
+
+  int logicalOr() {
+    int left = logicalAnd();
+    while (!error && accept("||")) {
+      left = node(OP2('|', '|'), left, logicalAnd());
+    }
+    return left;
+  }
+
+  int logicalAnd() {
+    int left = bitOr();
+    while (!error && accept("&&")) {
+      left = node(OP2('&', '&'), left, bitOr());
+    }
+    return left;
+  }
+
+  int bitOr() {
+    int left = bitXor();
+    while (!error && accept("|")) {
+      left = node('|', left, bitXor());
+    }
+    return left;
+  }
+
+  int bitXor() {
+    int left = bitAnd();
+    while (!error && accept("^")) {
+      left = node('^', left, bitAnd());
+    }
+    return left;
+  }
+
+  int bitAnd() {
+    int left = equality();
+    while (!error && accept("&")) {
+      left = node('&', left, equality());
+    }
+    return left;
+  }
+
+  int equality() {
+    int left = relational();
+    for (;;) {
+      if (accept("==")) {
+        left = node(OP2('=', '='), left, relational());
+      } else if (accept("!=")) {
+        left = node(OP2('!', '='), left, relational());
+      } else {
+        return left;
+      }
+    }
+  }
+
+  int relational() {
+    int left = shift();
+    for (;;) {
+      if (accept("<=")) {
+        left = node(OP2('<', '='), left, shift());
+      } else if (accept(">=")) {
+        left = node(OP2('>', '='), left, shift());
+      } else if (accept("<")) {
+        left = node('<', left, shift());
+      } else if (accept(">")) {
+        left = node('>', left, shift());
+      } else {
+        return left;
+      }
+    }
+  }
+
+  int shift() {
+    int left = additive();
+    for (;;) {
+      if (accept("<<")) {
+        left = node(OP2('<', '<'), left, additive());
+      } else if (accept(">>")) {
+        left = node(OP2('>', '>'), left, additive());
+      } else {
+        return left;
+      }
+    }
+  }
+
+  int additive() {
+    int left = multiplicative();
+    for (;;) {
+      if (accept("+")) {
+        left = node('+', left, multiplicative());
+      } else if (accept("-")) {
+        left = node('-', left, multiplicative());
+      } else {
+        return left;
+      }
+    }
+  }
+
+  int multiplicative() {
+    int left = power();
+    for (;;) {
+      if (accept("*")) {
+        left = node('*', left, power());
+      } else if (accept("/")) {
+        left = node('/', left, power());
+      } else if (accept("%")) {
+        left = node('%', left, power());
+      } else {
+        return left;
+      }
+    }
+  }
+
+  int power() {
+    int left = unary();
+    if (!error && accept("**")) {
+      return node(OP2('*', '*'), left, power()); // right to left
+    }
+    return left;
+  }
+
+  int unary() {
+    if (accept("++") || accept("--")) {
+      bool inc = p[-1] == '+';
+      int operand = unary();
+      if (error || expr._nodes[operand].op != VARIABLE) {
+        error = true;
+        return operand;
+      }
+      int n = node(inc ? PREINC : PREDEC);
+      expr._nodes[n].name = expr._nodes[operand].name;
+      return n;
+    }
+    if (accept("-")) {
+      return node(NEGATE, unary());
+    }
+    if (accept("+")) {
+      return node(PLUS, unary());
+    }
+    if (accept("!")) {
+      return node(NOT, unary());
+    }
+    if (accept("~")) {
+      return node(COMPLEMENT, unary());
+    }
+    return postfix();
+  }
+
+  int postfix() {
+    int operand = primary();
+    if (!error && expr._nodes[operand].op == VARIABLE && (accept("++") || accept("--"))) {
+      int n = node(p[-1] == '+' ? POSTINC : POSTDEC);
+      expr._nodes[n].name = expr._nodes[operand].name;
+      return n;
+    }
+    return operand;
+  }
+
+  int primary() {
+    skipSpaces();
+    if (p >= end) {
+      error = true;
+      return node(NUMBER);
+    }
+
+    if (*p == '(') {
+      p++;
+      int inner = comma();
+      if (!accept(")")) {
+        error = true;
+      }
+      return inner;
+    }
+
+    // Numbers: 42, 0x2a, 052
+    if (isdigit((unsigned char) *p)) {
+      char *after;
+      std::string digits(p, end - p);
+      long long value = strtoll(digits.c_str(), &after, 0);
+      p += after - digits.c_str();
+      int n = node(NUMBER);
+      expr._nodes[n].value = value;
+      return n;
+    }
+
+    // Variables: name, $name, ${name}
+    bool braces = false;
+    if (*p == '$') {
+      p++;
+      if (p < end && *p == '{') {
+        braces = true;
+        p++;
+      }
+    }
+    const char *start = p;
+    while (p < end && (isalnum((unsigned char) *p) || *p == '_')) {
+      p++;
+    }
+    if (p == start || isdigit((unsigned char) *start)) {
+      error = true;
+      return node(NUMBER);
+    }
+    int n = node(VARIABLE);
+    expr._nodes[n].name.assign(start, p - start);
+    if (braces) {
+      if (p < end && *p == '}') {
+        p++;
+      } else {
+        error = true;
+      }
+    }
+    return n;
+  }
+};
+
+
+
+// Walks the tree of one expression
+struct ArithEvaluator {
+
+  const ArithExpression &expr;
+  bool error;
+
+  ArithEvaluator(const ArithExpression &e) : expr(e), error(false) {}
+
+  long long variable(const std::string &name) {
+    const char *value = Variables::get(name.c_str(), name.size());
+    if (value == NULL || *value == '\0') {
+      return 0;
+    }
+    return strtoll(value, NULL, 0);
+  }
+
+  long long assign(const std::string &name, long long value) {
+    Variables::set(name.c_str(), std::to_string(value).c_str(), false);
+    return value;
+  }
+
+  long long divide(int op, long long a, long long b) {
+    if (b == 0) {
+      fprintf(stderr, "arithmetic: division by zero\n");
+      error = true;
+      return 0;
+    }
+    if (b == -1) {
+      // LLONG_MIN / -1 overflows, wrap like the other operators do
+      return op == '/' ? (long long) (0 - (unsigned long long) a) : 0;
+    }
+    return op == '/' ? a / b : a % b;
+  }
+
+  long long eval(int index) {
+
+    // After an error nothing else runs (1/0 + x++ leaves x alone)
+    if (error) {
+      return 0;
+    }
+    const ArithNode &n = expr._nodes[index];
+
+    switch (n.op) {
+      case NUMBER:     return n.value;
+      case VARIABLE:   return variable(n.name);
+      case NEGATE:     return (long long) (0 - (unsigned long long) eval(n.a));
+      case PLUS:       return eval(n.a);
+      case NOT:        return !eval(n.a);
+      case COMPLEMENT: return ~eval(n.a);
+      case PREINC:     return assign(n.name, variable(n.name) + 1);
+      case PREDEC:     return assign(n.name, variable(n.name) - 1);
+      case POSTINC:  { long long v = variable(n.name); assign(n.name, v + 1); return v; }
+      case POSTDEC:  { long long v = variable(n.name); assign(n.name, v - 1); return v; }
+
+      // Only evaluate what C would
+      case OP2('&', '&'): return eval(n.a) ? eval(n.b) != 0 : 0;
+      case OP2('|', '|'): return eval(n.a) ? 1 : eval(n.b) != 0;
+      case '?':           return eval(n.a) ? eval(n.b) : eval(n.c);
+      case ',':           eval(n.a); return eval(n.b);
+
+      case '=': return assign(n.name, eval(n.a));
+      case SHL_ASSIGN: return assign(n.name, (long long) ((unsigned long long) variable(n.name) << (eval(n.a) & 63)));
+      case SHR_ASSIGN: return assign(n.name, variable(n.name) >> (eval(n.a) & 63));
+    }
+
+    // Compound assignment: x op= y is x = x op y
+    if (n.op >= 256 && (n.op & 255) == '=' && n.op != OP2('=', '=') && n.op != OP2('!', '=') &&
+        n.op != OP2('<', '=') && n.op != OP2('>', '=')) {
+      return assign(n.name, binary(n.op >> 8, variable(n.name), eval(n.a)));
+    }
+
+    long long a = eval(n.a);
+    long long b = eval(n.b);
+    return binary(n.op, a, b);
+  }
+
+  long long binary(int op, long long a, long long b) {
+
+    // Wrap around on overflow instead of undefined behaviour
+    unsigned long long ua = a, ub = b;
+
+    switch (op) {
+      case '+': return (long long) (ua + ub);
+      case '-': return (long long) (ua - ub);
+      case '*': return (long long) (ua * ub);
+      case '/':
+      case '%': return divide(op, a, b);
+      case '&': return a & b;
+      case '|': return a | b;
+      case '^': return a ^ b;
+      case '<': return a < b;
+      case '>': return a > b;
+      case OP2('<', '<'): return (long long) (ua << (b & 63));
+      case OP2('>', '>'): return a >> (b & 63);
+      case OP2('=', '='): return a == b;
+      case OP2('!', '='): return a != b;
+      case OP2('<', '='): return a <= b;
+      case OP2('>', '='): return a >= b;
+      case OP2('*', '*'): {
+        if (b < 0) {
+          fprintf(stderr, "arithmetic: exponent less than 0\n");
+          error = true;
+          return 0;
+        }
+        unsigned long long result = 1;
+        while (b > 0) {
+          if (b & 1) {
+            result *= ua;
+          }
+          ua *= ua;
+          b >>= 1;
+        }
+        return (long long) result;
+      }
+    }
+    return 0;
+  }
+};
+
+
+
+// Parsed expressions by text
+static std::unordered_map<std::string, ArithExpression> cache;
+
+bool Arithmetic::evaluate(const char *text, size_t length, long long &result) {
+
+  std::string key(text, length);
+  auto found = cache.find(key);
+
+  if (found == cache.end()) {
+    if (cache.size() >= 1024) {
+      cache.clear();
+    }
+    ArithExpression expr;
+    ArithParser parser(text, length, expr);
+    parser.skipSpaces();
+    if (parser.p == parser.end) {
+      // $(()) is 0
+      expr._root = parser.node(NUMBER);
+    }
+    else {
+      expr._root = parser.comma();
+      parser.skipSpaces();
+    }
+    expr._valid = !parser.error && parser.p == parser.end;
+    found = cache.emplace(key, expr).first;
+  }
+
+  const ArithExpression &expr = found->second;
+  if (!expr._valid) {
+    fprintf(stderr, "arithmetic: syntax error in '%s'\n", key.c_str());
+    result = 0;
+    return false;
+  }
+
+  ArithEvaluator evaluator(expr);
+  result = evaluator.eval(expr._root);
+  return !evaluator.error;
+}
@@ -0,0 +1,36 @@
+#ifndef arith_hh
+#define arith_hh
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+/* $((...)) arithmetic
+ * 64 bit signed integers, C operators and precedence (plus ** like bash),
+ * assignments (= += -= ... ++ --) and variables by name, with or without $.
+ * Each expression text is parsed once into a tree of nodes and cached, a
+ * loop evaluating the same $((i + 1)) over and over only walks the tree.
+ */
+
+struct ArithNode {
+  int op;            // token of the operator, or NUMBER / VARIABLE
+  long long value;   // NUMBER
+  std::string name;  // VARIABLE, and the target of assignments
+  int a, b, c;       // operands (node indexes, -1 if none)
+};
+
+struct ArithExpression {
+  std::vector<ArithNode> _nodes;
+  int _root;
+  bool _valid; // false: syntax error, reported when it is used
+};
+
+struct Arithmetic {
+
+  // Evaluate 'expr'. Errors (syntax, division by zero) are printed and give false
+  static bool evaluate(const char *expr, size_t length, long long &result);
+};
+
+#endif
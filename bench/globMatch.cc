@@ -0,0 +1,54 @@
+// GlobPattern (glob.cc) against the regcomp/regexec way filename globs used
+// to be matched, over 1M made up file names. Built by bench/globMatch.sh.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <regex.h>
+
+#include "glob.hh"
+
+typedef std::chrono::steady_clock Clock;
+
+static double ms(Clock::time_point from, Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+int main() {
+
+  // file-<scrambled number>.log, one in ten .txt
+  std::vector<std::string> names;
+  for (long long i = 0; i < 1000000; i++) {
+    names.push_back("file-" + std::to_string(i * 7919 % 1000003) + (i % 10 ? ".log" : ".txt"));
+  }
+
+  // The same patterns as wildcard_to_regex used to write them
+  const char *globs[] = { "*.txt", "file-12*", "*-9?9*.log", "[fg]ile-*7.txt" };
+  const char *regexes[] = { "^.*\\.txt$", "^file-12.*$", "^.*-9.9.*\\.log$", "^[fg]ile-.*7\\.txt$" };
+
+  for (int p = 0; p < 4; p++) {
+    Clock::time_point start = Clock::now();
+    GlobPattern glob(globs[p], strlen(globs[p]));
+    size_t globMatches = 0;
+    for (auto & name : names) {
+      globMatches += glob.match(name.data(), name.size());
+    }
+
+    Clock::time_point middle = Clock::now();
+    regex_t regex;
+    regcomp(&regex, regexes[p], REG_EXTENDED | REG_NOSUB);
+    size_t regexMatches = 0;
+    for (auto & name : names) {
+      regexMatches += regexec(&regex, name.c_str(), 0, NULL, 0) == 0;
+    }
+    regfree(&regex);
+    Clock::time_point end = Clock::now();
+
+    printf("%-16s glob %6.1fms  regex %7.1fms  %zu matches%s\n", globs[p],
+           ms(start, middle), ms(middle, end), globMatches,
+           globMatches == regexMatches ? "" : " (regex disagrees!)");
+  }
+  return 0;
+}
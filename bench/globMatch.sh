@@ -0,0 +1,11 @@
+#!/bin/bash
+# Glob matcher vs regex over 1M names (bench/globMatch.cc)
+#
+#   bench/globMatch.sh
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+g++ -O2 -I"$SRC" -o "$TMP/globMatch" "$SRC/bench/globMatch.cc" "$SRC/glob.cc" || exit 1
+"$TMP/globMatch"
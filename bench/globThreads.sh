@@ -0,0 +1,30 @@
+#!/bin/bash
+# Glob thread scaling: tree/*/*/*.gz over a synthetic 64 x 64 x 8 tree with
+# GLOB_THREADS=1, 2, 4, 8. The listings are in the page cache after the
+# first run, so this measures the CPU side (getdents, matching, merging).
+#
+#   bench/globThreads.sh [path/to/shell] [runs]
+
+SHELL_BIN=${1:-./shell}
+RUNS=${2:-20}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+for ((a = 0; a < 64; a++)); do
+  for ((b = 0; b < 64; b++)); do
+    mkdir -p "$TMP/tree/$a/$b"
+    touch "$TMP/tree/$a/$b/"{1,2,3,4}.gz "$TMP/tree/$a/$b/"{1,2,3,4}.txt
+  done
+done
+
+for ((i = 0; i < RUNS; i++)); do
+  echo "true $TMP/tree/*/*/*.gz"
+done > "$TMP/glob.sh"
+
+echo "cores: $(nproc)"
+for threads in 1 2 4 8; do
+  start=$(date +%s%N)
+  GLOB_THREADS=$threads "$SHELL_BIN" < "$TMP/glob.sh" > /dev/null
+  end=$(date +%s%N)
+  printf 'GLOB_THREADS=%d  %6.1f ms/expansion\n' $threads "$(( (end - start) / RUNS / 1000 ))e-3"
+done
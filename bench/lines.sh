@@ -0,0 +1,28 @@
+#!/bin/bash
+# Script input throughput: lines per second for a generated script of
+# 70 byte builtin lines (nothing is started), through stdin and through
+# source.
+#
+#   bench/lines.sh [path/to/shell] [N]
+
+SHELL_BIN=${1:-./shell}
+N=${2:-100000}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+for ((i = 0; i < N; i++)); do
+  echo "true $i abcdefghij klmnopqrst uvwxyz0123 4567890abc defghijklm"
+done > "$TMP/script.sh"
+echo "source $TMP/script.sh" > "$TMP/source.sh"
+
+# Lines per second for a script on stdin
+run() {
+  local start end
+  start=$(date +%s%N)
+  "$SHELL_BIN" < "$1" > /dev/null
+  end=$(date +%s%N)
+  echo $(( N * 1000000000 / (end - start) ))
+}
+
+printf 'stdin  %8d lines/s\n' "$(run "$TMP/script.sh")"
+printf 'source %8d lines/s\n' "$(run "$TMP/source.sh")"
@@ -0,0 +1,38 @@
+#!/bin/bash
+# Spawn latency: N external commands, posix_spawn vs fork + execve
+# (SHELL_LAUNCH, see launch.cc). Run twice, with a small shell and with one
+# holding ~100MB of array data, where fork has a lot more page tables to copy.
+#
+#   bench/spawn.sh [path/to/shell] [N]
+
+SHELL_BIN=${1:-./shell}
+N=${2:-5000}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+for ((i = 0; i < N; i++)); do
+  echo /bin/true
+done > "$TMP/small.sh"
+
+# mapfile keeps every line in the shell, not in the environment
+yes xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx | head -3000000 > "$TMP/data"
+echo "mapfile -t data $TMP/data" > "$TMP/load.sh"
+cat "$TMP/load.sh" "$TMP/small.sh" > "$TMP/big.sh"
+echo true > "$TMP/empty.sh" # builtin
+
+# Microseconds to run a script
+run() {
+  local start end
+  start=$(date +%s%N)
+  SHELL_LAUNCH=$1 "$SHELL_BIN" < "$2" > /dev/null
+  end=$(date +%s%N)
+  echo $(( (end - start) / 1000 ))
+}
+
+for mode in spawn fork; do
+  for size in small big; do
+    base=$(run $mode "$TMP/$([ $size = small ] && echo empty || echo load).sh")
+    total=$(run $mode "$TMP/$size.sh")
+    printf '%-6s %-6s %6d us/command\n' $mode $size $(( (total - base) / N ))
+  done
+done
@@ -0,0 +1,28 @@
+#!/bin/bash
+# Command substitution: one $(...) capturing 10MB, and N small $(...)
+# (the shell has no loops, the script has N lines).
+#
+#   bench/subst.sh [path/to/shell] [N]
+
+SHELL_BIN=${1:-./shell}
+N=${2:-10000}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+yes 'some output of a command' | head -c 10000000 > "$TMP/10mb"
+echo "true \$(cat $TMP/10mb)" > "$TMP/big.sh"
+for ((i = 0; i < N; i++)); do
+  echo 'true $(echo hi)'
+done > "$TMP/small.sh"
+
+# Seconds to run a script
+run() {
+  local start end
+  start=$(date +%s%N)
+  "$SHELL_BIN" < "$1" > /dev/null
+  end=$(date +%s%N)
+  printf '%d.%03d' $(( (end - start) / 1000000000 )) $(( (end - start) / 1000000 % 1000 ))
+}
+
+echo "10MB:     $(run "$TMP/big.sh")s"
+echo "$N x \$(echo hi): $(run "$TMP/small.sh")s"
@@ -0,0 +1,30 @@
+#!/bin/bash
+# System calls the shell itself makes per pipeline of 1..4 /bin/true, with
+# bench/syscount.cc (ptrace, the children aren't counted).
+#
+#   bench/syscalls.sh [path/to/shell] [N]
+
+SHELL_BIN=${1:-./shell}
+N=${2:-200}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+g++ -O2 -o "$TMP/syscount" "$(dirname "$0")/syscount.cc" || exit 1
+
+# Syscalls for a script
+count() {
+  "$TMP/syscount" "$SHELL_BIN" < "$1" 2>&1 > /dev/null | tail -1
+}
+
+echo true > "$TMP/base.sh" # builtin
+base=$(count "$TMP/base.sh")
+
+pipeline=/bin/true
+for length in 1 2 3 4; do
+  for ((i = 0; i < N; i++)); do
+    echo "$pipeline"
+  done > "$TMP/run.sh"
+  total=$(count "$TMP/run.sh")
+  printf '%d command(s): %3d syscalls/pipeline\n' $length $(( (total - base) / N ))
+  pipeline="$pipeline | /bin/true"
+done
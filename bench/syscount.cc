@@ -0,0 +1,54 @@
+// Count the system calls a program makes itself (not its children), a
+// poor man's strace -c for bench/syscalls.sh:
+//
+//   syscount command args... < input
+//
+// Prints the count on stderr. Children started with posix_spawn or fork
+// aren't traced, only the shell's own work is counted.
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: syscount command args...\n");
+    return 2;
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+    raise(SIGSTOP);
+    execvp(argv[1], argv + 1);
+    perror(argv[1]);
+    _exit(127);
+  }
+
+  int status;
+  waitpid(pid, &status, 0);
+  ptrace(PTRACE_SETOPTIONS, pid, NULL, (void *) (long) (PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL));
+
+  // Every syscall stops twice (entry and exit)
+  long stops = 0;
+  int signal = 0;
+  for (;;) {
+    ptrace(PTRACE_SYSCALL, pid, NULL, (void *) (long) signal);
+    if (waitpid(pid, &status, 0) < 0 || WIFEXITED(status) || WIFSIGNALED(status)) {
+      break;
+    }
+    signal = 0;
+    if (WSTOPSIG(status) == (SIGTRAP | 0x80)) {
+      stops++;
+    }
+    else if (WSTOPSIG(status) != SIGTRAP) {
+      signal = WSTOPSIG(status); // SIGCHLD... goes on to the program
+    }
+  }
+
+  fprintf(stderr, "%ld\n", (stops + 1) / 2);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
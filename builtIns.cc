@@ -0,0 +1,728 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "builtIns.hh"
+#include "shell.hh"
+#include "pathCache.hh"
+#include "variables.hh"
+#include "dirCache.hh"
+
+void source(const char *); // source builtIn function, in shell.l
+
+
+
+/* Handle one backslash escape (echo -e, printf format and %b)
+ * 'p' points right after the backslash, returns how many chars were used.
+ * Sets 'stop' for \c (stop printing completely)
+ */
+static int print_escape(const char *p, bool *stop) {
+
+  switch (*p) {
+    case 'n': putchar('\n'); return 1;
+    case 't': putchar('\t'); return 1;
+    case 'r': putchar('\r'); return 1;
+    case 'a': putchar('\a'); return 1;
+    case 'b': putchar('\b'); return 1;
+    case 'f': putchar('\f'); return 1;
+    case 'v': putchar('\v'); return 1;
+    case '\\': putchar('\\'); return 1;
+    case 'c': *stop = true; return 1;
+    case '0': {
+      // \0nnn octal
+      int value = 0;
+      int used = 1;
+      while (used < 4 && p[used] >= '0' && p[used] <= '7') {
+        value = value * 8 + (p[used] - '0');
+        used++;
+      }
+      putchar(value);
+      return used;
+    }
+    case '\0':
+      putchar('\\');
+      return 0;
+    default:
+      // Unknown escape, print it as is
+      putchar('\\');
+      putchar(*p);
+      return 1;
+  }
+}
+
+
+
+/* Builtins that must run in the shell.
+ * They change the shell itself (current directory, environment...), if a
+ * child process handled them the changes would not persist after the
+ * child terminates.
+ */
+
+int builtIn_exit(SimpleCommand *) {
+  printf("Good bye!!\n");
+  exit(1);
+}
+
+
+
+// Built in function to handle 'cd'
+// ex: cd something
+int builtIn_cd(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  // No directory or ${HOME} literal string --> go to home directory
+  if (argc < 2 || !strcmp(args[1], "${HOME}")) {
+
+    // Get the home env
+    const char *home = Variables::get("HOME");
+    if (home != NULL) {
+      chdir(home); // Change dir. to home dir.
+    }
+    return 0;
+  }
+
+  // Tru and go to given directory
+  if (chdir(args[1]) < 0) {
+    fprintf(stderr, "cd: can't cd to %s\n", args[1]);
+    return 1;
+  }
+  return 0;
+}
+
+
+
+// BuiltIN function to handle setenv
+// setenv A B
+// "a[i]" --> "a" and "i", false for a plain name
+static bool splitSubscript(const char *text, std::string &name, std::string &subscript) {
+  const char *open = strchr(text, '[');
+  size_t length = strlen(text);
+  if (open == NULL || open == text || text[length - 1] != ']') {
+    return false;
+  }
+  name.assign(text, open - text);
+  subscript.assign(open + 1, text + length - 1 - open - 1);
+  return true;
+}
+
+int builtIn_setenv(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  // Check for correct size, 3
+  if (argc != 3) {
+    fprintf(stderr, "setenv: usage: setenv name value\n");
+    return 1;
+  }
+
+  // setenv 'a[i]' value --> array element. 'setenv a value' on an array is a[0]
+  std::string name, subscript;
+  if (splitSubscript(args[1], name, subscript)) {
+    return Variables::setElement(name, subscript, args[2]) ? 0 : 1;
+  }
+  if (Variables::array(args[1]) != NULL) {
+    return Variables::setElement(args[1], "0", args[2]) ? 0 : 1;
+  }
+
+  // Exported, overwritten if it already exists
+  Variables::set(args[1], args[2], true);
+
+  // New PATH --> cached command paths are useless
+  if (!strcmp(args[1], "PATH")) {
+    PathCache::invalidate();
+  }
+  return 0;
+}
+
+
+
+// Function to handle unsetenv builtIn Function
+// unsetenv A
+int builtIn_unsetenv(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc != 2) {
+    fprintf(stderr, "unsetenv: usage: unsetenv name\n");
+    return 1;
+  }
+
+  std::string name, subscript;
+  if (splitSubscript(args[1], name, subscript)) {
+    Variables::unsetElement(name, subscript);
+    return 0;
+  }
+
+  Variables::unset(args[1]);
+
+  if (!strcmp(args[1], "PATH")) {
+    PathCache::invalidate();
+  }
+  return 0;
+}
+
+
+
+// source file
+int builtIn_source(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc < 2) {
+    fprintf(stderr, "source: filename argument required\n");
+    return 2;
+  }
+
+  // The sourced commands are parsed into Shell::_currentCommand too,
+  // so take the file name out of it and clear it first
+  std::string file = args[1];
+  Shell::_currentCommand.clear();
+
+  source(file.c_str()); // Call source() on file provided
+  return 0;
+}
+
+
+
+// declare -a name [value ...]      indexed array
+// declare -A name [key=value ...]  associative array
+// Replaces whatever 'name' was before
+int builtIn_declare(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc < 3 || (strcmp(args[1], "-a") && strcmp(args[1], "-A"))) {
+    fprintf(stderr, "declare: usage: declare -a name [value ...] | declare -A name [key=value ...]\n");
+    return 2;
+  }
+
+  bool associative = args[1][1] == 'A';
+  Variables::Array &array = Variables::makeArray(args[2], associative);
+
+  for (size_t i = 3; i < argc; i++) {
+    if (!associative) {
+      array.items.emplace_hint(array.items.end(), i - 3, args[i]);
+      continue;
+    }
+    const char *eq = strchr(args[i], '=');
+    if (eq == NULL) {
+      array.keys[args[i]] = "";
+    }
+    else {
+      array.keys[std::string(args[i], eq - args[i])] = eq + 1;
+    }
+  }
+  return 0;
+}
+
+
+
+/* mapfile [-t] name [file]
+ * Every line of 'file' (or stdin) into the indexed array 'name',
+ * -t drops the newlines.
+ * A regular file is mmap'd and cut up with memchr, which glibc already
+ * does 16/32 bytes at a time, so there is no getline() or stdio copy per
+ * line. A pipe is read in big chunks first and cut up the same way.
+ */
+int builtIn_mapfile(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  size_t i = 1;
+  bool trim = i < argc && !strcmp(args[i], "-t");
+  if (trim) {
+    i++;
+  }
+  if (i >= argc || argc - i > 2) {
+    fprintf(stderr, "mapfile: usage: mapfile [-t] name [file]\n");
+    return 2;
+  }
+  const char *name = args[i];
+
+  int fd = 0;
+  if (argc - i == 2) {
+    fd = open(args[i + 1], O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      perror(args[i + 1]);
+      return 1;
+    }
+  }
+
+  const char *data = NULL;
+  size_t size = 0;
+  void *mapped = MAP_FAILED;
+  size_t mappedSize = 0;
+  std::string buffer;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    // stdin may already be partly read, start where it is
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset >= 0 && st.st_size > offset) {
+      mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        mappedSize = st.st_size;
+        madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+        data = (const char *) mapped + offset;
+        size = st.st_size - offset;
+        lseek(fd, st.st_size, SEEK_SET); // all of it was read
+      }
+    }
+  }
+
+  if (mapped == MAP_FAILED) {
+    char chunk[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+      buffer.append(chunk, n);
+    }
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  Variables::Array &array = Variables::makeArray(name, false);
+
+  const char *p = data;
+  const char *end = data + size;
+  while (p < end) {
+    const char *newline = (const char *) memchr(p, '\n', end - p);
+    const char *next = newline != NULL ? newline + 1 : end;
+    const char *stop = trim && newline != NULL ? newline : next;
+    array.items.emplace_hint(array.items.end(), array.items.size(), std::string(p, stop - p));
+    p = next;
+  }
+
+  if (mapped != MAP_FAILED) {
+    munmap(mapped, mappedSize);
+  }
+  if (fd != 0) {
+    close(fd);
+  }
+  return 0;
+}
+
+
+
+// Function to handle the 'hash' builtIn function
+// 'hash'          --> print the command table
+// 'hash -r'       --> forget every cached path
+// 'hash cmd ...'  --> look up the commands and remember them
+int builtIn_hash(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc == 1) {
+    PathCache::print();
+  }
+
+  int status = 0;
+  for (size_t i = 1; i < argc; i++) {
+    if (!strcmp(args[i], "-r")) {
+      PathCache::invalidate();
+    } else if (PathCache::lookup(args[i]) == NULL) {
+      fprintf(stderr, "hash: %s: not found\n", args[i]);
+      status = 1;
+    }
+  }
+  return status;
+}
+
+
+
+// Function to handle the 'type' builtIn function
+// Says what running each name would do
+int builtIn_type(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  int status = 0;
+  for (size_t i = 1; i < argc; i++) {
+    const char *name = args[i];
+
+    if (findBuiltIn(name) != NULL) {
+      printf("%s is a shell builtin\n", name);
+      continue;
+    }
+
+    bool hashed = PathCache::_table.count(name) > 0;
+    const char *path = PathCache::lookup(name);
+    if (path == NULL) {
+      fprintf(stderr, "type: %s: not found\n", name);
+      status = 1;
+    } else if (hashed) {
+      printf("%s is hashed (%s)\n", name, path);
+    } else {
+      printf("%s is %s\n", name, path);
+    }
+  }
+  return status;
+}
+
+
+
+// echo [-neE] [arg ...]
+int builtIn_echo(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  bool newline = true;
+  bool escapes = false;
+
+  // Options only count if every letter is one of n, e, E
+  size_t i = 1;
+  for (; i < argc; i++) {
+    const char *opt = args[i];
+    if (opt[0] != '-' || opt[1] == '\0' || strspn(opt + 1, "neE") != strlen(opt + 1)) {
+      break;
+    }
+    for (const char *c = opt + 1; *c; c++) {
+      if (*c == 'n') {
+        newline = false;
+      } else if (*c == 'e') {
+        escapes = true;
+      } else {
+        escapes = false;
+      }
+    }
+  }
+
+  bool stop = false;
+  for (size_t first = i; i < argc && !stop; i++) {
+    if (i > first) {
+      putchar(' ');
+    }
+
+    if (!escapes) {
+      fputs(args[i], stdout);
+      continue;
+    }
+
+    for (const char *p = args[i]; *p && !stop; p++) {
+      if (*p == '\\') {
+        p += print_escape(p + 1, &stop);
+      } else {
+        putchar(*p);
+      }
+    }
+  }
+
+  if (newline && !stop) {
+    putchar('\n');
+  }
+  return 0;
+}
+
+
+
+// printf format [argument ...]
+// The format is reused as long as there are arguments left (like bash)
+int builtIn_printf(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc < 2) {
+    fprintf(stderr, "printf: usage: printf format [arguments]\n");
+    return 2;
+  }
+
+  const char *format = args[1];
+  size_t next = 2;
+  int status = 0;
+  bool stop = false;
+
+  do {
+    size_t start = next;
+
+    for (const char *p = format; *p && !stop; p++) {
+
+      if (*p == '\\') {
+        p += print_escape(p + 1, &stop);
+        continue;
+      }
+
+      if (*p != '%') {
+        putchar(*p);
+        continue;
+      }
+
+      if (p[1] == '%') {
+        putchar('%');
+        p++;
+        continue;
+      }
+
+      // Copy the conversion spec: %[flags][width][.precision]conv
+      std::string spec = "%";
+      p++;
+      while (*p && strchr("-+ #0", *p)) {
+        spec += *p++;
+      }
+      while (*p && (isdigit((unsigned char)*p) || *p == '.')) {
+        spec += *p++;
+      }
+
+      if (*p == '\0') {
+        fputs(spec.c_str(), stdout);
+        break;
+      }
+
+      // Missing arguments act like "" or 0
+      const char *arg = "";
+      if (next < argc) {
+        arg = args[next++];
+      }
+
+      char conv = *p;
+      char *end = NULL;
+      switch (conv) {
+        case 'd':
+        case 'i':
+          spec += "lld";
+          printf(spec.c_str(), strtoll(arg, &end, 0));
+          break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+          spec += "ll";
+          spec += conv;
+          printf(spec.c_str(), strtoull(arg, &end, 0));
+          break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+          spec += conv;
+          printf(spec.c_str(), strtod(arg, &end));
+          break;
+        case 'c':
+          spec += 'c';
+          printf(spec.c_str(), arg[0]);
+          break;
+        case 's':
+          spec += 's';
+          printf(spec.c_str(), arg);
+          break;
+        case 'b':
+          // String with backslash escapes
+          for (const char *b = arg; *b && !stop; b++) {
+            if (*b == '\\') {
+              b += print_escape(b + 1, &stop);
+            } else {
+              putchar(*b);
+            }
+          }
+          break;
+        default:
+          fprintf(stderr, "printf: %c: invalid format character\n", conv);
+          return 1;
+      }
+
+      // Numbers that were not completely numbers
+      if (end != NULL && (end == arg || *end != '\0') && *arg != '\0') {
+        fprintf(stderr, "printf: %s: invalid number\n", arg);
+        status = 1;
+      }
+    }
+
+    // Stop if the format did not use any argument (avoids looping forever)
+    if (next == start) {
+      break;
+    }
+  } while (next < argc && !stop);
+
+  return status;
+}
+
+
+
+int builtIn_true(SimpleCommand *) {
+  return 0;
+}
+
+int builtIn_false(SimpleCommand *) {
+  return 1;
+}
+
+
+
+int builtIn_pwd(SimpleCommand *) {
+
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    perror("pwd");
+    return 1;
+  }
+  printf("%s\n", cwd);
+  return 0;
+}
+
+
+
+// printenv        --> print the whole environment
+// printenv A B    --> print the values of A and B
+int builtIn_printenv(SimpleCommand *simpleCommand) {
+
+  char **args = simpleCommand->argv();
+  size_t argc = simpleCommand->size();
+
+  if (argc == 1) {
+    // Loop through and print the env variables
+    for (char **env = Variables::envp(); *env; env++) {
+      printf("%s\n", *env);
+    }
+    return 0;
+  }
+
+  int status = 0;
+  for (size_t i = 1; i < argc; i++) {
+    const char *value = Variables::get(args[i]);
+    if (value == NULL) {
+      status = 1;
+    } else {
+      printf("%s\n", value);
+    }
+  }
+  return status;
+}
+
+
+
+// arenastat: allocation counters of the command arena.
+// Run a command a few times, 'mallocs' should stop growing.
+int builtIn_arenastat(SimpleCommand *) {
+  Shell::_currentCommand._arena.printStats();
+  return 0;
+}
+
+
+
+// dircache: counters of the glob directory cache (GLOB_CACHE)
+// dircache -r: forget every listing
+int builtIn_dircache(SimpleCommand *simpleCommand) {
+  if (simpleCommand->size() > 1 && !strcmp(simpleCommand->argv()[1], "-r")) {
+    DirCache::clear();
+    return 0;
+  }
+  DirCache::print();
+  return 0;
+}
+
+
+
+/* The registry
+ * Adding a builtin = adding a line here, the hash table below is rebuilt
+ * by the compiler.
+ */
+static constexpr BuiltIn builtInList[] = {
+  { "exit",      builtIn_exit,       BUILTIN_PARENT },
+  { "cd",        builtIn_cd,         BUILTIN_PARENT },
+  { "setenv",    builtIn_setenv,     BUILTIN_PARENT },
+  { "unsetenv",  builtIn_unsetenv,   BUILTIN_PARENT },
+  { "source",    builtIn_source,     BUILTIN_PARENT },
+  { "hash",      builtIn_hash,       BUILTIN_PARENT },
+  { "declare",   builtIn_declare,    BUILTIN_PARENT },
+  { "mapfile",   builtIn_mapfile,    BUILTIN_PARENT },
+  { "type",      builtIn_type,       BUILTIN_IN_PROCESS },
+  { "echo",      builtIn_echo,       BUILTIN_IN_PROCESS },
+  { "printf",    builtIn_printf,     BUILTIN_IN_PROCESS },
+  { "true",      builtIn_true,       BUILTIN_IN_PROCESS },
+  { "false",     builtIn_false,      BUILTIN_IN_PROCESS },
+  { "pwd",       builtIn_pwd,        BUILTIN_IN_PROCESS },
+  { "printenv",  builtIn_printenv,   BUILTIN_IN_PROCESS },
+  { "arenastat", builtIn_arenastat,  BUILTIN_IN_PROCESS },
+  { "dircache",  builtIn_dircache,   BUILTIN_IN_PROCESS },
+};
+
+static constexpr int NUM_BUILTINS = sizeof(builtInList) / sizeof(builtInList[0]);
+
+// Slots in the hash table, power of 2 and at least twice the builtins
+static constexpr int TABLE_BITS = 6;
+static constexpr int TABLE_SIZE = 1 << TABLE_BITS;
+static_assert(TABLE_SIZE >= 2 * NUM_BUILTINS, "grow TABLE_SIZE");
+
+
+
+// FNV-1a hash of a name, 'seed' is picked so that no two builtins collide
+static constexpr unsigned int hashName(const char *name, unsigned int seed) {
+  unsigned int h = 2166136261u ^ seed;
+  for (; *name; name++) {
+    h = (h ^ (unsigned char)*name) * 16777619u;
+  }
+  // Top bits, the low bits of FNV barely change with the seed
+  return (h & 0xffffffffu) >> (32 - TABLE_BITS);
+}
+
+// True if every builtin lands in a different slot with this seed
+static constexpr bool isPerfect(unsigned int seed) {
+  bool used[TABLE_SIZE] = {};
+  for (int i = 0; i < NUM_BUILTINS; i++) {
+    unsigned int slot = hashName(builtInList[i].name, seed);
+    if (used[slot]) {
+      return false;
+    }
+    used[slot] = true;
+  }
+  return true;
+}
+
+static constexpr unsigned int findSeed() {
+  for (unsigned int seed = 0; seed < 10000; seed++) {
+    if (isPerfect(seed)) {
+      return seed;
+    }
+  }
+  return ~0u;
+}
+
+static constexpr unsigned int SEED = findSeed();
+static_assert(SEED != ~0u, "no perfect hash seed for the builtins, grow TABLE_SIZE");
+
+// slot --> index in builtInList (-1 = empty)
+struct BuiltInTable {
+  signed char index[TABLE_SIZE];
+};
+
+static constexpr BuiltInTable buildTable() {
+  BuiltInTable table = {};
+  for (int i = 0; i < TABLE_SIZE; i++) {
+    table.index[i] = -1;
+  }
+  for (int i = 0; i < NUM_BUILTINS; i++) {
+    table.index[hashName(builtInList[i].name, SEED)] = i;
+  }
+  return table;
+}
+
+static constexpr BuiltInTable builtInTable = buildTable();
+
+
+
+// One hash and one strcmp per command
+const BuiltIn *findBuiltIn(const char *name) {
+
+  int i = builtInTable.index[hashName(name, SEED)];
+  if (i < 0 || strcmp(builtInList[i].name, name) != 0) {
+    return NULL;
+  }
+  return &builtInList[i];
+}
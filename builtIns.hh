@@ -0,0 +1,51 @@
+#ifndef builtins_hh
+#define builtins_hh
+
+#include "simpleCommand.hh"
+
+
+
+// Builtin registry
+// Every builtin has the same signature and returns its exit code (used for ${?}).
+// The table is hashed at compile time so finding a builtin is one lookup,
+// no matter how many there are.
+
+// Where a builtin has to run
+enum BuiltInKind {
+  BUILTIN_PARENT,     // Changes the shell itself (cd, setenv...), always runs in the shell
+  BUILTIN_IN_PROCESS  // Only prints, runs in the shell when stand-alone, in a child inside a pipeline
+};
+
+typedef int (*BuiltInFunction)(SimpleCommand *);
+
+struct BuiltIn {
+  const char *name;
+  BuiltInFunction function;
+  BuiltInKind kind;
+};
+
+// Returns the registry entry for 'name', or NULL if it is not a builtin
+const BuiltIn *findBuiltIn(const char *name);
+
+// Must run in the shell
+int builtIn_exit(SimpleCommand *simpleCommand);
+int builtIn_cd(SimpleCommand *simpleCommand);
+int builtIn_setenv(SimpleCommand *simpleCommand);
+int builtIn_unsetenv(SimpleCommand *simpleCommand);
+int builtIn_source(SimpleCommand *simpleCommand);
+int builtIn_hash(SimpleCommand *simpleCommand);
+int builtIn_declare(SimpleCommand *simpleCommand);
+int builtIn_mapfile(SimpleCommand *simpleCommand);
+
+// Only print something
+int builtIn_type(SimpleCommand *simpleCommand);
+int builtIn_echo(SimpleCommand *simpleCommand);
+int builtIn_printf(SimpleCommand *simpleCommand);
+int builtIn_true(SimpleCommand *simpleCommand);
+int builtIn_false(SimpleCommand *simpleCommand);
+int builtIn_pwd(SimpleCommand *simpleCommand);
+int builtIn_printenv(SimpleCommand *simpleCommand);
+int builtIn_arenastat(SimpleCommand *simpleCommand);
+int builtIn_dircache(SimpleCommand *simpleCommand);
+
+#endif
@@ -1,3 +1,4 @@
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 
@@ -5,9 +6,12 @@
 
 #include "command.hh"
 #include "shell.hh"
+#include "launch.hh"
+#include "pathCache.hh"
+#include "variables.hh"
+#include "builtIns.hh"
 
-extern char **environ;
-void source(const char *); // source builtIn function
+void shell_input_sync(); // in shell.l
 
 int code = 0;
 int last_pid = 0;
@@ -15,8 +19,8 @@ int exit_code = 0;
 
 std::string last_arg = "";
 
-// Vector of paths for source substitution thingy stuff i hate this
-std::vector<std::string> Command::_cleanup_paths;
+// Shell ends of the line's <(...) and >(...) pipes, closed when execute() returns
+std::vector<int> Command::_substitutionFds;
 
 
 
@@ -28,6 +32,7 @@ Command::Command() {
     _inFile = NULL;
     _errFile = NULL;
     _background = false;
+    _expansionFailed = false;
 
     // Initialize enum to default (overwrite)
     _outMode = OVERWRITE;
@@ -39,37 +44,27 @@ void Command::insertSimpleCommand( SimpleCommand * simpleCommand ) {
 }
 
 void Command::clear() {
-    // deallocate all the simple commands in the command vector
-
+    // The simple commands live in the arena, just run their destructors
     for (auto simpleCommand : _simpleCommands) {
-        delete simpleCommand;
+        simpleCommand->~SimpleCommand();
     }
 
-
     // remove all references to the simple commands we've deallocated
     // (basically just sets the size to 0)
     _simpleCommands.clear();
 
-    if ( _outFile ) {
-        delete _outFile;
-    }
+    // File names are in the arena too
     _outFile = NULL;
-
-    if ( _inFile ) {
-        delete _inFile;
-    }
     _inFile = NULL;
-
-    if ( _errFile ) {
-        delete _errFile;
-    }
-
-
     _errFile = NULL;
 
     _background = false;
+    _expansionFailed = false;
 
     _outMode = OVERWRITE;
+
+    // Free everything from this command line at once
+    _arena.reset();
 }
 
 
@@ -92,9 +87,9 @@ void Command::print() {
     printf( "  Output       Input        Error        Background     Append\n");
     printf( "  ------------ ------------ ------------ ------------ ------------\n" );
     printf( "  %-12s %-12s %-12s %-12s %-12s\n",
-            _outFile?_outFile->c_str():"default",
-            _inFile?_inFile->c_str():"default",
-            _errFile?_errFile->c_str():"default",
+            _outFile?_outFile:"default",
+            _inFile?_inFile:"default",
+            _errFile?_errFile:"default",
             _background?"YES":"NO",
             _outMode?"YES":"NO");
     printf( "\n\n" );
@@ -102,349 +97,317 @@ void Command::print() {
 
 
 
-// Built in function to handle 'cd'
-bool Command::builtIn_cd() {
-
-  // Store the first and second arg of the command
-  // ex: cd something
-  std::string *first_arg = _simpleCommands[0]->_arguments[0];
-  std::string *second_arg = _simpleCommands[0]->_arguments[1];
+/* Run a builtin in the shell process with some descriptors redirected.
+ * stdin/stdout/stderr are swapped to the redirection files just for the call,
+ * then put back. Returns the builtin's exit code.
+ */
+static int runBuiltInHere(BuiltInFunction builtIn, SimpleCommand *simpleCommand, int fdin, int fdout, int fderr) {
 
-  // Verify first arg is 'cd'
-  if (*first_arg == "cd") {
+  fflush(stdout);
+  fflush(stderr);
 
-    // Check if second arg is null or is ${HOME} literal string
-    // If so, go to home directory
-    if (second_arg == nullptr || *second_arg == "${HOME}") {
-
-      // Get the home env
-      const char *home = getenv("HOME");
-      if (home != nullptr) {
-
-        chdir(home); // Change dir. to home dir.
-      }
-    } else { // Tru and go to given directory from second_arg
-
-      // Get the direcotry from second_arg
-      int dir_found = chdir(second_arg->c_str());
-
-      // if 'dir_found' is negative --> directory not found
-      // Print error message
-      if (dir_found < 0) {
-
-        // Error message
-        std::string error = "cd: can't cd to ";
-        error.append(second_arg->c_str());
-        fprintf(stderr, "%s\n", error.c_str());
-      }
-    }
-
-    // Clear and print new prompt
-    clear();
-    Shell::prompt();
-    return true;
+  // Save the shell's own descriptors only if they get redirected
+  int savedIn = -1;
+  int savedOut = -1;
+  int savedErr = -1;
+  if (fdin != 0) {
+    savedIn = fcntl(0, F_DUPFD_CLOEXEC, 10);
+    dup2(fdin, 0);
+  }
+  if (fdout != 1) {
+    savedOut = fcntl(1, F_DUPFD_CLOEXEC, 10);
+    dup2(fdout, 1);
+  }
+  if (fderr != 2) {
+    savedErr = fcntl(2, F_DUPFD_CLOEXEC, 10);
+    dup2(fderr, 2);
   }
 
-  // shouldnt be here
-  return false;
-
-
-}
+  int status = builtIn(simpleCommand);
 
-// BuiltIN function to handle setenv
-bool Command::builtIn_setenv() {
+  fflush(stdout);
+  fflush(stderr);
 
-  // Check for correct size, 3
-  // setenv A B
-  if (_simpleCommands[0]->_arguments.size() != 3) {
-    perror("setenv");
+  if (savedIn >= 0) {
+    dup2(savedIn, 0);
+    close(savedIn);
+  }
+  if (savedOut >= 0) {
+    dup2(savedOut, 1);
+    close(savedOut);
+  }
+  if (savedErr >= 0) {
+    dup2(savedErr, 2);
+    close(savedErr);
   }
 
-  // setenv(A, B, 1)
-  // '1' means to overwrite if the env. var. already exists
-  setenv(_simpleCommands[0]->_arguments[1]->c_str(), _simpleCommands[0]->_arguments[2]->c_str(), 1);
-  clear();
-  Shell::prompt();
-  return true;
+  return status;
 }
 
-
-// Function to handle unsetenv builtIn Function
-bool Command::builtIn_unsetenv() {
-
-  // Checkk for correct size
-  // 'unsetenv A'
-  if (_simpleCommands[0]->_arguments.size() != 2) {
-    perror("unsetenv");
+// Close the files opened for <, > and 2> (not the shell's own 0/1/2)
+static void closeRedirections(int fdin, int fdout, int fderr) {
+  if (fdin != 0) {
+    close(fdin);
   }
-
-  // Call: 'unsetenv(A)
-  if (unsetenv(_simpleCommands[0]->_arguments[1]->c_str())) {
-    perror("unsetenv");
+  if (fdout != 1) {
+    close(fdout);
+  }
+  if (fderr != 2) {
+    close(fderr);
   }
-
-  clear();
-  Shell::prompt();
-  return true;
 }
 
-
-// TODO
-// Need to handle source and printenv
+/* However execute() returns: the process substitution descriptors are
+ * closed (a >(...) reader only gets EOF then), the table is cleared and
+ * the prompt printed
+ */
+struct ExecuteDone {
+  Command *command;
+  ~ExecuteDone() {
+    Command::performCleanup();
+    command->clear();
+    Shell::prompt();
+  }
+};
 
 void Command::execute() {
+    // Every return below goes through here
+    ExecuteDone done = { this };
+
+    // Like bash, a failed expansion (the error is printed) skips the line
+    if (_expansionFailed) {
+        code = 1;
+        return;
+    }
+
     // Don't do anything if there are no simple commands
     if (_simpleCommands.empty()) {
-        Shell::prompt();
         return;
     }
 
+    // A script on stdin: commands reading stdin start at its next line
+    shell_input_sync();
+
     // print();
 
 
     // get the first command
     // Used for builtIn functions
-    std::string *cmd = _simpleCommands[0]->_arguments[0];
+    const char *cmd = _simpleCommands[0]->argument(0);
 
-    // Handle exit command
-    if (*cmd == "exit") {
-      printf("Good bye!!\n");
-      exit(1);
-    }
+    // One registry lookup tells if this is a builtin and where it runs
+    const BuiltIn *builtIn = findBuiltIn(cmd);
 
-    /* Handle the 'cd' command
-     * This is handled in the parent process, because it affects current,
-     * working directory. If the child handled this then the changes (changing directories),
-     * would not persist after the child terminates.
+    /* Redirection plan
+     * The shell never touches its own 0/1/2 anymore. For every stage we
+     * only compute which descriptor becomes the child's stdin/stdout/stderr,
+     * and the child (or posix_spawn's file actions) does the dup2s.
+     * Everything we open here is O_CLOEXEC so children never inherit it
+     * by accident.
      */
-    if (*cmd == "cd") {
-      builtIn_cd();
-      clear();
-      return;
-    }
-
-    /* Handle the 'setenv' builtin function
-     * 'setenv' 'unsetenv both modify environmental variables,
-     * which are normally stored in the parent process. Once again,
-     * if handled in the child process, the changes would not persist,
-     * after the child terminates.
-     */
-    if (*cmd == "setenv") {
-      builtIn_setenv();
-      return;
-    }
-
-    // Handle the 'unsetenv' command
-    if (*cmd == "unsetenv") {
-      builtIn_unsetenv();
-      return;
-    }
 
-    /* Handle the 'source' command
-     * If this was handled in the child process the changes made would,
-     * not persist after the child process termiantes.
+    /*
+     * _inFile: input of the first command
+     * _errFile: Applies globally, all commands' stderr go there
+     * _outFile: only applies to last command in pipeline
      */
-    if (*cmd == "source") {
-      _simpleCommands.clear(); // Clear commands
-      source(_simpleCommands[0]->_arguments[1]->c_str()); // Call source() on file provided
-      return;
-    }
-
 
-
-    // Save default file descriptors
-    int defaultin = dup(0); // stdin
-    int defaultout = dup(1); // stdout
-    int defaulterr = dup(2); // stderr
-
-    // Initialize file descriptors
-    // These vars. will be set to point to files or pipes
+    // Initialize file descriptors to the shell's own stdin/stdout/stderr
     int fdin = 0;
-    int fdout = 0; 
-    int fderr = 0;
+    int fdout = 1;
+    int fderr = 2;
 
     // print comamnd table
     //print();
 
-
-
-    /*
-     * Why is _infile and _errfile set up before for loop?
-     * _inFile: To see if input file is provided, so shell can read from that file
-     * _errFile: Applies globally, all commands' stderr go there,
-                 Each chlid process inherits this file descriptor
-     */
-
-     /* Why is _outFile not used before for loop?
-      * _outfile only applies to last command in pipeline
-      */
-
-
-
     // Set up input redirection
     if (_inFile) { // inpute file was given
-        fdin = open(_inFile->c_str(), O_RDONLY);
+        fdin = open(_inFile, O_RDONLY | O_CLOEXEC);
         if (fdin < 0) {
-
-            // open failed: print error and resotre og file descriptores
             perror("Error opening input file");
-            dup2(defaultin, 0);
-            dup2(defaultout, 1);
-            dup2(defaulterr, 2);
-            close(defaultin);
-            close(defaultout);
-            close(defaulterr);
-            clear();
-            Shell::prompt();
             return;
         }
-    } else {
-        fdin = dup(defaultin); // No input file --> use stdin
     }
 
     // Set up error redirection
     if (_errFile) { // if error file is given
         if (_outMode == APPEND) { // Check if append or not based on enum value
-            fderr = open(_errFile->c_str(), O_CREAT | O_WRONLY | O_APPEND, 0664);
+            fderr = open(_errFile, O_CREAT | O_WRONLY | O_APPEND | O_CLOEXEC, 0664);
         } else { // truncate
-            fderr = open(_errFile->c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0664);
+            fderr = open(_errFile, O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0664);
         }
         if (fderr < 0) {
             perror("Error opening error file");
-            dup2(defaultin, 0);
-            dup2(defaultout, 1);
-            dup2(defaulterr, 2);
-            close(defaultin);
-            close(defaultout);
-            close(defaulterr);
-            close(fdin);
-            clear();
-            Shell::prompt();
+            if (fdin != 0) {
+              close(fdin);
+            }
             return;
         }
-    } else {
-        fderr = dup(defaulterr); // no error file --> use stderr
     }
 
-    // Apply error redirection for the entire pipeline
-    // Makes sure any error output from command in pipeline goes to correct destination
-    dup2(fderr, 2);
-    close(fderr);
+    // Set up output redirection for the last command
+    if (_outFile) {
+        if (_outMode == APPEND) {
+            fdout = open(_outFile, O_CREAT | O_WRONLY | O_APPEND | O_CLOEXEC, 0664);
+        } else {
+            fdout = open(_outFile, O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0664);
+        }
+        if (fdout < 0) {
+            perror("Error opening output file");
+            if (fdin != 0) {
+              close(fdin);
+            }
+            if (fderr != 2) {
+              close(fderr);
+            }
+            return;
+        }
+    }
+
+
+    /* Builtins that change the shell (exit, cd, setenv, unsetenv, source, hash,
+     * declare, mapfile)
+     * If they were handled in a child process, the changes (current directory,
+     * environment...) would not persist after the child terminates.
+     * Redirections apply to them like to anything else (mapfile a < file,
+     * hash > file), only for the duration of the call.
+     */
+    if (builtIn != NULL && builtIn->kind == BUILTIN_PARENT) {
+      code = runBuiltInHere(builtIn->function, _simpleCommands[0], fdin, fdout, fderr);
+      exit_code = code;
+      closeRedirections(fdin, fdout, fderr);
+      return;
+    }
+
+    /* Stand-alone printing builtin (echo, printf, true, false, pwd, printenv)
+     * Nothing to connect to, so run it right here instead of forking.
+     * Inside a pipeline it still gets its own child below.
+     */
+    if (builtIn != NULL && builtIn->kind == BUILTIN_IN_PROCESS &&
+        _simpleCommands.size() == 1 && !_background) {
+
+      code = runBuiltInHere(builtIn->function, _simpleCommands[0], 0, fdout, fderr);
+      exit_code = code;
+      closeRedirections(fdin, fdout, fderr);
+
+      last_arg = _simpleCommands[0]->argument(_simpleCommands[0]->size() - 1);
+      return;
+    }
 
 
     // Process each command in the pipeline
-    pid_t lastPid;
+    pid_t lastPid = -1;
+    int startFailure = 0; // $? when the last command couldn't be started
     for (size_t i = 0; i < _simpleCommands.size(); i++) {
 
-        // Redirect input to so current command can read from it
-        dup2(fdin, 0);
-        close(fdin);
+        FdPlan plan;
+        plan.in = fdin;
+        plan.err = fderr;
+        plan.closeFrom = closeFrom();
 
         // Set up output
         if (i == _simpleCommands.size() - 1) { // last command in the pipeline
-
-            // Last command: use specified output file or default
-            if (_outFile) {
-                if (_outMode == APPEND) {
-                    fdout = open(_outFile->c_str(), O_CREAT | O_WRONLY | O_APPEND, 0664);
-                } else {
-                    fdout = open(_outFile->c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0664);
-                }
-                if (fdout < 0) {
-                    perror("Error opening output file");
-                    dup2(defaultin, 0);
-                    dup2(defaultout, 1);
-                    dup2(defaulterr, 2);
-                    close(defaultin);
-                    close(defaultout);
-                    close(defaulterr);
-                    clear();
-                    Shell::prompt();
-                    return;
-                }
-            } else {
-                fdout = dup(defaultout); // no output file -- >use stdout
-            }
+            plan.out = fdout;
         } else {
 
-           // Not the last command: create a pipe
+            // Not the last command: create a pipe
             int fdpipe[2];
-            if (pipe(fdpipe) < 0) {
+            if (pipe2(fdpipe, O_CLOEXEC) < 0) {
                 perror("pipe");
                 exit(1);
             }
-            fdout = fdpipe[1];  // Write end of pipe
-            fdin = fdpipe[0];   // Read end for next command
+            plan.out = fdpipe[1];  // Write end of pipe
+            fdin = fdpipe[0];      // Read end for next command
         }
 
-        // Redirect output
-        dup2(fdout, 1);
-        close(fdout);
-
-
-        // Fork and execute
-        pid_t pid = fork();
 
         // Get size of arguement. Used of expand_var_underscore test
-        size_t argsize = _simpleCommands[i]->_arguments.size();
-        if (pid == -1) {
-            perror("fork");
-            exit(2);
+        size_t argsize = _simpleCommands[i]->size();
+
+        // argv for exec, already packed by SimpleCommand (no copying)
+        char **args = _simpleCommands[i]->argv();
+
+        /* Only fork when the child really needs a copy of the shell.
+         * Builtins in a pipeline run inside the child (printenv prints the
+         * shell's environment...), everything else is just exec'd so
+         * posix_spawn is enough.
+         */
+        const BuiltIn *stageBuiltIn = findBuiltIn(args[0]);
+        bool needsFork = stageBuiltIn != NULL;
+
+        // Resolve the command through the hash table.
+        // Unknown commands are reported here, no point forking for them
+        const char *path = NULL;
+        if (!needsFork) {
+          path = PathCache::lookup(args[0]);
         }
 
-        if (pid == 0) {
-          // Child process
-
-          // Handle printenv function
-          // Handle in child process as it just prints environmental variables of the shell.
-          // It does not modify anything so is can be done in child process
-          if (!strcmp(_simpleCommands[i]->_arguments[0]->c_str(), "printenv")) {
+        pid_t pid;
+        if (!needsFork && path == NULL) {
+          dprintf(plan.err, "%s: command not found\n", args[0]);
+          pid = -1;
+          startFailure = 127;
+        } else if (Launcher::_mode == LAUNCH_SPAWN && !needsFork) {
+          pid = Launcher::spawn(path, args, plan);
+          startFailure = errno == ENOENT ? 127 : 126;
+        } else {
 
-            // Loop through and print the env variables
-            for (char **env = environ; *env; env++) {
-              printf("%s\n", *env);
-            }
-            exit(0);
+          // Fork and execute
+          pid = fork();
+          if (pid == -1) {
+              perror("fork");
+              exit(2);
           }
 
-            // Build argv vector for execvp
-            char **args = new char*[argsize + 1];
-            for (size_t j = 0; j < argsize; j++) {
-                args[j] = const_cast<char*>(_simpleCommands[i]->_arguments[j]->c_str());
-                args[j][strlen(_simpleCommands[i]->_arguments[j]->c_str())] = '\0';
+          if (pid == 0) {
+            // Child process: move the planned descriptors into 0/1/2
+            Launcher::applyPlan(plan);
 
+            // Builtin in a pipeline: run it in this child
+            if (stageBuiltIn != NULL) {
+              int status = stageBuiltIn->function(_simpleCommands[i]);
+              fflush(stdout);
+              _exit(status);
             }
-            args[argsize] = NULL;
 
-            // Close file descriptors
-            close(defaultin);
-            close(defaultout);
-            close(defaulterr);
+            // Execute command, path was already looked up in the parent
+            execve(path, args, Variables::envp());
+            perror("execv");
+            _exit(errno == ENOENT ? 127 : 126);  // Use _exit in child process
+          }
+        }
 
-            // Execute command
-            execvp(args[0], args);
-            perror("execvp");
-            _exit(1);  // Use _exit in child process
+        // The child has its copies now, close the parent's ends
+        // (the last output file is closed after the loop)
+        if (plan.in != 0) {
+          close(plan.in);
+        }
+        if (plan.out != fdout) {
+          close(plan.out);
         }
 
         // Store last process ID for waiting
         lastPid = pid;
 
-        last_arg = strdup(_simpleCommands[i]->_arguments[argsize-1]->c_str());
+        last_arg = args[argsize-1];
 
     }
 
-    // Restore default file descriptors
-    dup2(defaultin, 0);
-    dup2(defaultout, 1);
-    dup2(defaulterr, 2);
-    close(defaultin);
-    close(defaultout);
-    close(defaulterr);
+    // Close redirection files
+    if (fdout != 1) {
+      close(fdout);
+    }
+    if (fderr != 2) {
+      close(fderr);
+    }
 
     // If not running in background --> wait for last process to finish
     int stat = 0;
-    if (!_background) {
+    if (lastPid < 0) {
+      // Last command could not be started: 127 not found, 126 can't run it (like bash)
+      code = startFailure;
+      exit_code = code;
+    } else if (!_background) {
       waitpid(lastPid, &stat, 0);
       code = WEXITSTATUS(stat); // USED FOR ${?}
       exit_code = code; // USED FOR EXTRA CREDIT
@@ -465,13 +428,6 @@ void Command::execute() {
       }
     }*/
 
-
-    // Clean up proccess substitution resources
-    performCleanup();
-
-    // clear table and print new prompt (myshell> )
-    clear();
-    Shell::prompt();
 }
 
 
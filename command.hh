@@ -20,11 +20,18 @@
 
 struct Command {
   std::vector<SimpleCommand *> _simpleCommands;
-  std::string * _outFile;
-  std::string * _inFile;
-  std::string * _errFile;
+  char * _outFile;
+  char * _inFile;
+  char * _errFile;
   bool _background;
 
+  // A word of the line didn't expand ($((1/0))): the line is not run
+  bool _expansionFailed;
+
+  // Everything parsed for this command line (tokens, simple commands,
+  // arguments, file names) is allocated here and dropped at once by clear()
+  Arena _arena;
+
 
   // Enum to track appending to file or overwriting ( >, >>)
   enum RedirectMode { OVERWRITE, APPEND };
@@ -38,13 +45,6 @@ struct Command {
   void execute();
 
 
-  // Built in function declaration (2.6)
-  bool builtIn_cd();
-
-  bool builtIn_setenv();
-
-  bool builtIn_unsetenv();
-
   static SimpleCommand *_currentSimpleCommand;
 
 
@@ -52,37 +52,33 @@ struct Command {
 
 
 
-  // List of stringg in a vector, like an arrat
-  // Stores paths of FIFOs and the temp. directories created during process sub.
-  // Makes sure paths are cleaned up to avoid problems
-  static std::vector<std::string> _cleanup_paths; 
+  // Descriptors the shell holds for process substitution, <(...) and >(...).
+  // The commands of the line use them as /dev/fd/N, so unlike everything
+  // else the shell opens they are not O_CLOEXEC.
+  static std::vector<int> _substitutionFds;
 
-  // Adds a file path to _cleanup_paths
-  static void addCleanupPath(const std::string& path) {
-    _cleanup_paths.push_back(path);
+  static void addSubstitutionFd(int fd) {
+    _substitutionFds.push_back(fd);
   }
 
-  // Function to remove all stored FIFOs and directoreies once not needed
-  static void performCleanup() {
-
-    // Loop thorugh _cleanup_paths
-    // could look like: /tmp/shell-12345/fifo
-    //                  /tmp/shell-12345
-    for (const std::string& path : _cleanup_paths) {
-
-      // unlink() deletes the files
-      // 'path.c_str()' holds the file path
-      unlink(path.c_str());  // Remove FIFO
-
-      // If path contains '/shell-' is is temp. directory
-      if (path.find("/shell-") != std::string::npos) {
-        // If this is a temp directory path (contains /shell-), try to remove it
-        rmdir(path.c_str());
+  // First descriptor a child may close, the substitution ones stay open
+  static int closeFrom() {
+    int from = 3;
+    for (int fd : _substitutionFds) {
+      if (fd >= from) {
+        from = fd + 1;
       }
     }
+    return from;
+  }
 
-    // clear list for future use
-    _cleanup_paths.clear();
+  // Once the line's commands are started the shell's copies go away
+  // (a >(...) reader only sees EOF when every write end is closed)
+  static void performCleanup() {
+    for (int fd : _substitutionFds) {
+      close(fd);
+    }
+    _substitutionFds.clear();
   }
 };
 
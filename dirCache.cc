@@ -0,0 +1,144 @@
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "dirCache.hh"
+#include "variables.hh"
+
+std::unordered_map<DirCache::Key, DirCache::Slot, DirCache::KeyHash> DirCache::_table;
+std::list<DirCache::Key> DirCache::_lru;
+std::mutex DirCache::_lock;
+size_t DirCache::_limit = 0;
+size_t DirCache::_bytes = 0;
+size_t DirCache::_hits = 0;
+size_t DirCache::_misses = 0;
+size_t DirCache::_evictions = 0;
+
+
+
+static bool sameTime(const struct timespec &a, const struct timespec &b) {
+  return a.tv_sec == b.tv_sec && a.tv_nsec == b.tv_nsec;
+}
+
+
+
+void DirCache::configure() {
+
+  const char *value = Variables::get("GLOB_CACHE");
+  size_t limit = value != NULL && atol(value) > 0 ? (size_t) atol(value) * 1024 * 1024 : 0;
+
+  std::lock_guard<std::mutex> lock(_lock);
+  _limit = limit;
+  evict();
+}
+
+
+
+std::shared_ptr<const DirListing> DirCache::lookup(int fd) {
+
+  if (_limit == 0) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return NULL;
+  }
+  Key key = { st.st_dev, st.st_ino };
+
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    auto found = _table.find(key);
+    if (found != _table.end()) {
+      Slot &slot = found->second;
+      if (sameTime(slot.mtime, st.st_mtim) && sameTime(slot.ctime, st.st_ctim)) {
+        _hits++;
+        _lru.splice(_lru.begin(), _lru, slot.lru);
+        return slot.listing;
+      }
+      // Changed since
+      _bytes -= slot.bytes;
+      _lru.erase(slot.lru);
+      _table.erase(found);
+    }
+    _misses++;
+  }
+
+  // Read it, without the lock: other threads go on meanwhile
+  std::shared_ptr<DirListing> listing = std::make_shared<DirListing>();
+  std::vector<char> buffer(DIRENT_BUFFER);
+  long size;
+  while ((size = syscall(SYS_getdents64, fd, buffer.data(), buffer.size())) > 0) {
+    for (long offset = 0; offset < size; ) {
+      LinuxDirent64 *entry = (LinuxDirent64 *) (buffer.data() + offset);
+      offset += entry->d_reclen;
+      DirListing::Entry item = { (unsigned) listing->names.size(), entry->d_type };
+      listing->entries.push_back(item);
+      listing->names += entry->d_name;
+      listing->names += '\0';
+    }
+  }
+  if (size < 0) {
+    return NULL;
+  }
+
+  size_t bytes = sizeof(DirListing) + listing->names.capacity() +
+                 listing->entries.capacity() * sizeof(DirListing::Entry);
+
+  // Too fresh: another change in the same tick would keep the same mtime
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  bool settled = st.st_mtim.tv_sec < now.tv_sec - 1 && st.st_ctim.tv_sec < now.tv_sec - 1;
+
+  std::lock_guard<std::mutex> lock(_lock);
+  if (settled && bytes <= _limit && _table.find(key) == _table.end()) {
+    _lru.push_front(key);
+    Slot slot = { listing, st.st_mtim, st.st_ctim, bytes, _lru.begin() };
+    _table.emplace(key, slot);
+    _bytes += bytes;
+    evict();
+  }
+  return listing;
+}
+
+
+
+// Drop the least recently used listings until we are under the cap
+// (called with the lock held)
+void DirCache::evict() {
+  while (_bytes > _limit && !_lru.empty()) {
+    auto found = _table.find(_lru.back());
+    _bytes -= found->second.bytes;
+    _table.erase(found);
+    _lru.pop_back();
+    _evictions++;
+  }
+}
+
+
+
+void DirCache::clear() {
+  std::lock_guard<std::mutex> lock(_lock);
+  _table.clear();
+  _lru.clear();
+  _bytes = 0;
+}
+
+
+
+void DirCache::print() {
+  std::lock_guard<std::mutex> lock(_lock);
+  if (_limit == 0) {
+    printf("directory cache off (setenv GLOB_CACHE <MB> to turn it on)\n");
+  }
+  else {
+    printf("limit:        %zu bytes\n", _limit);
+  }
+  printf("directories:  %zu (%zu bytes)\n", _table.size(), _bytes);
+  printf("hits:         %zu\n", _hits);
+  printf("misses:       %zu\n", _misses);
+  printf("evictions:    %zu\n", _evictions);
+}
@@ -0,0 +1,99 @@
+#ifndef dircache_hh
+#define dircache_hh
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+
+
+// Entries are read straight with getdents64, this many bytes per call
+// (readdir() asks for 32K at a time)
+#define DIRENT_BUFFER (64 * 1024)
+
+// What getdents64 fills the buffer with
+struct LinuxDirent64 {
+  unsigned long long d_ino;
+  long long d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+
+// Names and d_types of one directory
+struct DirListing {
+  struct Entry {
+    unsigned name;      // offset in 'names'
+    unsigned char type; // d_type
+  };
+  std::string names;    // every name, NUL terminated
+  std::vector<Entry> entries;
+};
+
+
+
+/* Opt-in cache of directory listings for filename globs (GLOB_CACHE=<MB>).
+ * ls *.log, tail *.log, grep x *.log... read the same directories over and
+ * over, with the cache a repeated glob costs one fstat of the directory.
+ * Listings are keyed by (dev, inode) and only used while the directory's
+ * mtime and ctime are the same as when it was read. A directory changed
+ * in the last second isn't kept, the same mtime could still hide another
+ * change. The least recently used listings go when the cap is reached.
+ * Glob threads share it, so everything is behind one mutex.
+ */
+
+struct DirCache {
+
+  struct Key {
+    dev_t dev;
+    ino_t ino;
+    bool operator==(const Key &other) const { return dev == other.dev && ino == other.ino; }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const { return std::hash<unsigned long long>()(key.ino * 31 + key.dev); }
+  };
+
+  struct Slot {
+    std::shared_ptr<const DirListing> listing;
+    struct timespec mtime;
+    struct timespec ctime;
+    size_t bytes;
+    std::list<Key>::iterator lru;
+  };
+
+  static std::unordered_map<Key, Slot, KeyHash> _table;
+  static std::list<Key> _lru;   // most recently used first
+  static std::mutex _lock;
+  static size_t _limit;         // bytes, 0: cache off
+  static size_t _bytes;
+
+  // 'dircache' builtin
+  static size_t _hits;
+  static size_t _misses;
+  static size_t _evictions;
+
+  // Read GLOB_CACHE, before a glob starts its threads
+  static void configure();
+
+  // Listing of the directory open on 'fd', from the cache or read now (and
+  // kept). NULL if the cache is off or the directory can't be read, the
+  // caller reads it itself then
+  static std::shared_ptr<const DirListing> lookup(int fd);
+
+  // Forget everything ('dircache -r')
+  static void clear();
+
+  // Counters for 'dircache'
+  static void print();
+
+private:
+  static void evict();
+};
+
+#endif
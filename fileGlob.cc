@@ -0,0 +1,599 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "fileGlob.hh"
+#include "dirCache.hh"
+#include "variables.hh"
+
+// Directories waiting in the pool's queues hold an open descriptor each,
+// past this many the finder reads the subdirectory itself
+#define MAX_QUEUED 256
+
+// The helper threads are only started once this many directories are
+// waiting, */x over a handful of directories stays on one thread
+#define START_THREADS 16
+
+// ** keeps one buffer per directory level it is in, and a descriptor for
+// the deepest OPEN_LEVELS of them (the others are reopened by path)
+#define GLOBSTAR_BUFFER (16 * 1024)
+#define OPEN_LEVELS 32
+
+// Results at least this big are sorted by the threads
+#define PARALLEL_SORT (64 * 1024)
+
+
+
+// A directory still to read: components[index...] in 'fd'
+struct GlobTask {
+  size_t index;
+  int fd;
+  std::string prefix;
+};
+
+/* Work stealing: every thread has its own queue, takes its newest task
+ * (depth first, what it just opened is still in the cache) and when
+ * that's empty steals the oldest task of another thread (the biggest
+ * subtree left).
+ * The shell's thread starts alone and queues the directories it finds.
+ * Helpers are started when enough of them pile up, and sleep on 'wake'
+ * while there is nothing to steal.
+ */
+struct GlobPool {
+  const std::vector<FileGlob::Component> *components;
+  std::vector<std::deque<GlobTask>> queues;
+  std::vector<std::mutex> locks;
+  std::vector<std::vector<std::string>> results; // per thread, merged at the end
+  std::atomic<size_t> pending; // tasks queued or running
+  std::atomic<size_t> queued;  // tasks in the queues (= open descriptors)
+
+  std::vector<std::thread> helpers; // only touched by the shell's thread
+  std::atomic<bool> started;
+  std::mutex idle;
+  std::condition_variable wake; // a task was queued, or everything is done
+
+  GlobPool(unsigned threads) : queues(threads), locks(threads), results(threads), pending(0), queued(0), started(false) {}
+
+  // Queue a subdirectory for any thread. False if there are too many already
+  bool offer(unsigned worker, size_t index, int fd, const std::string &prefix) {
+    if (queued.load(std::memory_order_relaxed) >= MAX_QUEUED) {
+      return false;
+    }
+    pending++;
+    queued++;
+    {
+      std::lock_guard<std::mutex> lock(locks[worker]);
+      queues[worker].push_back(GlobTask{ index, fd, prefix });
+    }
+
+    // Taking 'idle' orders this with a helper about to sleep: it either
+    // sees the task or gets the notify
+    if (started.load()) {
+      { std::lock_guard<std::mutex> lock(idle); }
+      wake.notify_one();
+    }
+    else if (queues.size() > 1 && queued.load() >= START_THREADS) {
+      FileGlob::startHelpers(this);
+    }
+    return true;
+  }
+
+  // A task is finished
+  void done() {
+    if (--pending == 0) {
+      { std::lock_guard<std::mutex> lock(idle); }
+      wake.notify_all();
+    }
+  }
+
+  bool take(unsigned worker, GlobTask &task) {
+    for (unsigned k = 0; k < queues.size(); k++) {
+      unsigned victim = (worker + k) % queues.size();
+      std::lock_guard<std::mutex> lock(locks[victim]);
+      std::deque<GlobTask> &queue = queues[victim];
+      if (queue.empty()) {
+        continue;
+      }
+      if (victim == worker) {
+        task = queue.back();
+        queue.pop_back();
+      }
+      else {
+        task = queue.front();
+        queue.pop_front();
+      }
+      queued--;
+      return true;
+    }
+    return false;
+  }
+};
+
+
+
+unsigned FileGlob::threads() {
+  const char *value = Variables::get("GLOB_THREADS");
+  if (value != NULL && atoi(value) > 0) {
+    return atoi(value);
+  }
+  unsigned cores = std::thread::hardware_concurrency();
+  return cores == 0 ? 1 : cores > 8 ? 8 : cores;
+}
+
+
+
+void FileGlob::work(GlobPool *pool, unsigned worker) {
+  GlobTask task;
+  for (;;) {
+    if (pool->take(worker, task)) {
+      walk(*pool->components, task.index, task.fd, task.prefix, pool->results[worker], pool, worker);
+      close(task.fd);
+      pool->done();
+      continue;
+    }
+
+    // Nothing to steal: sleep until something is queued or all is done
+    std::unique_lock<std::mutex> lock(pool->idle);
+    pool->wake.wait(lock, [pool] { return pool->pending.load() == 0 || pool->queued.load() > 0; });
+    if (pool->pending.load() == 0) {
+      return;
+    }
+  }
+}
+
+
+
+// Every thread of ours starts with all signals blocked, SIGCHLD and SIGINT
+// (zombie(), ctrl_c()) stay with the shell's own thread
+template <class Function>
+static std::thread quietThread(Function function) {
+  sigset_t all, old;
+  sigfillset(&all);
+  pthread_sigmask(SIG_BLOCK, &all, &old);
+  std::thread thread(function);
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+  return thread;
+}
+
+
+
+// Only ever called from the shell's thread (in offer), once
+void FileGlob::startHelpers(GlobPool *pool) {
+  pool->started = true;
+  for (unsigned i = 1; i < pool->queues.size(); i++) {
+    pool->helpers.push_back(quietThread([pool, i] { work(pool, i); }));
+  }
+}
+
+
+
+bool FileGlob::expand(const std::string &pattern, std::vector<std::string> &paths) {
+
+  // Cut at the slashes, /usr/*/bin --> "/" + usr, *, bin
+  std::vector<Component> components;
+  std::string prefix = pattern[0] == '/' ? "/" : "";
+  size_t start = prefix.size();
+  for (;;) {
+    size_t slash = pattern.find('/', start);
+    size_t end = slash == std::string::npos ? pattern.size() : slash;
+
+    Component component;
+    component.pattern.compile(pattern.data() + start, end - start);
+    component.dot = end > start && pattern[start] == '.';
+    component.globstar = end - start == 2 && pattern.compare(start, 2, "**") == 0;
+
+    // **/** is the same as **
+    if (!component.globstar || components.empty() || !components.back().globstar) {
+      components.push_back(component);
+    }
+
+    if (slash == std::string::npos) {
+      break;
+    }
+    start = slash + 1;
+  }
+
+  int fd = open(prefix.empty() ? "." : "/", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  DirCache::configure();
+
+  size_t before = paths.size();
+
+  // Threads only pay off if there are directories to go down into,
+  // *.c or /usr/lib/*.so read just one. ** walks its tree on one thread
+  // (walkTree), only wildcards after it can use the others
+  bool deep = false;
+  for (size_t i = 0; i + 1 < components.size(); i++) {
+    deep = deep || (components[i].pattern._wildcard && !components[i].globstar);
+  }
+  unsigned count = deep ? threads() : 1;
+
+  if (count < 2) {
+    walk(components, 0, fd, prefix, paths, NULL, 0);
+    close(fd);
+    return paths.size() > before;
+  }
+
+  GlobPool pool(count);
+  pool.components = &components;
+  pool.pending = 1; // the top directory, this thread does it
+
+  walk(components, 0, fd, prefix, pool.results[0], &pool, 0);
+  close(fd);
+  pool.done();
+  work(&pool, 0);
+
+  for (auto & helper : pool.helpers) {
+    helper.join();
+  }
+  pool.helpers.clear();
+
+  for (auto & result : pool.results) {
+    paths.insert(paths.end(), std::make_move_iterator(result.begin()), std::make_move_iterator(result.end()));
+  }
+  return paths.size() > before;
+}
+
+
+
+void FileGlob::sort(std::vector<std::string> &paths) {
+
+  unsigned count = threads();
+  if (count < 2 || paths.size() < PARALLEL_SORT) {
+    std::sort(paths.begin(), paths.end());
+    return;
+  }
+
+  // One piece per thread, then merge neighbours two by two.
+  // Same order as one std::sort, equal strings can't be told apart
+  std::vector<size_t> bounds;
+  for (unsigned i = 0; i <= count; i++) {
+    bounds.push_back(paths.size() * i / count);
+  }
+
+  auto at = [&](size_t i) { return paths.begin() + bounds[i]; };
+
+  std::vector<std::thread> sorters;
+  for (unsigned i = 0; i < count; i++) {
+    sorters.push_back(quietThread([&, i] { std::sort(at(i), at(i + 1)); }));
+  }
+  for (auto & sorter : sorters) {
+    sorter.join();
+  }
+
+  for (size_t width = 1; width < count; width *= 2) {
+    std::vector<std::thread> mergers;
+    for (size_t i = 0; i + width < count; i += 2 * width) {
+      size_t end = std::min<size_t>(i + 2 * width, count);
+      mergers.push_back(quietThread([&, i, width, end] { std::inplace_merge(at(i), at(i + width), at(end)); }));
+    }
+    for (auto & merger : mergers) {
+      merger.join();
+    }
+  }
+}
+
+
+
+// Is 'name' in 'dirFd' a directory? d_type says it for free on most file
+// systems, only DT_UNKNOWN (and symlinks, which count if they point to a
+// directory) need a stat
+static bool isDirectory(int dirFd, const char *name, unsigned char type) {
+  if (type == DT_DIR) {
+    return true;
+  }
+  if (type != DT_UNKNOWN && type != DT_LNK) {
+    return false;
+  }
+  struct stat st;
+  return fstatat(dirFd, name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+}
+
+
+
+// A directory that matched couldn't be opened. Gone or not allowed is
+// fine (bash skips those too), anything else would silently leave paths
+// out of the expansion, so it is printed
+static void openError(const char *prefix, const char *name) {
+  if (errno != ENOENT && errno != EACCES && errno != ENOTDIR && errno != ELOOP) {
+    fprintf(stderr, "glob: %s%s: %s\n", prefix, name, strerror(errno));
+  }
+}
+
+
+
+// Match components[index...] in the directory open on 'dirFd'. 'prefix' is
+// its path as typed ("" is the current directory, otherwise it ends with a /).
+// Directories are only ever opened relative to their parent, and only the
+// ones the pattern goes into
+void FileGlob::walk(const std::vector<Component> &components, size_t index, int dirFd,
+                    const std::string &prefix, std::vector<std::string> &paths,
+                    GlobPool *pool, unsigned worker) {
+
+  const Component &component = components[index];
+  bool last = index + 1 == components.size();
+
+  if (component.globstar) {
+    walkTree(components, index, dirFd, prefix, paths, pool, worker);
+    return;
+  }
+
+  // Plain names: nothing to read. a/b/*: open a/b in one go,
+  // only a last plain name has to be checked
+  if (!component.pattern._wildcard) {
+    std::string names = component.pattern._text;
+    while (!last && !components[index + 1].pattern._wildcard && index + 2 < components.size()) {
+      index++;
+      names += "/" + components[index].pattern._text;
+    }
+    const char *path = names.empty() ? "." : names.c_str(); // src/*/ ends with ""
+
+    if (last) {
+      struct stat st;
+      if (fstatat(dirFd, path, &st, AT_SYMLINK_NOFOLLOW) == 0 && !(prefix.empty() && names.empty())) {
+        paths.push_back(prefix + names);
+      }
+      return;
+    }
+
+    int fd = openat(dirFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+      openError(prefix.c_str(), path);
+      return;
+    }
+    walk(components, index + 1, fd, prefix + names + "/", paths, pool, worker);
+    close(fd);
+    return;
+  }
+
+  // One entry of the directory
+  auto visit = [&](const char *name, unsigned char type) {
+
+    // Hidden names (. and .. too) only when the pattern starts with a dot
+    if (name[0] == '.' && !component.dot) {
+      return;
+    }
+
+    if (!component.pattern.match(name, strlen(name))) {
+      return;
+    }
+
+    if (last) {
+      paths.push_back(prefix + name);
+      return;
+    }
+
+    // More to come: only directories can have it
+    if (!isDirectory(dirFd, name, type)) {
+      return;
+    }
+    int fd = openat(dirFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+      openError(prefix.c_str(), name);
+      return;
+    }
+    if (pool == NULL || !pool->offer(worker, index + 1, fd, prefix + name + "/")) {
+      walk(components, index + 1, fd, prefix + name + "/", paths, pool, worker);
+      close(fd);
+    }
+  };
+
+  // GLOB_CACHE: the listing may already be known
+  std::shared_ptr<const DirListing> listing = DirCache::lookup(dirFd);
+  if (listing != NULL) {
+    for (auto & entry : listing->entries) {
+      visit(listing->names.data() + entry.name, entry.type);
+    }
+    return;
+  }
+
+  std::vector<char> buffer(DIRENT_BUFFER);
+  long size;
+  while ((size = syscall(SYS_getdents64, dirFd, buffer.data(), buffer.size())) > 0) {
+    for (long offset = 0; offset < size; ) {
+      LinuxDirent64 *entry = (LinuxDirent64 *) (buffer.data() + offset);
+      offset += entry->d_reclen;
+      visit(entry->d_name, entry->d_type);
+    }
+  }
+}
+
+
+
+// ** at components[index]: every directory under 'dirFd' (itself too) gets
+// the rest of the pattern.
+// Depth first with an explicit stack, one frame per level of the current
+// path (its descriptor and a small getdents buffer), and one path string
+// that grows and shrinks as the walk goes down and up. Memory depends on
+// the depth of the tree, not on how many entries it has.
+// Symlinks are not followed (same as bash), and a directory that is already
+// on the stack (dev, inode) is skipped so bind mount loops end too.
+// What comes after ** decides how much each directory costs:
+//   src/**           every entry is a result, nothing else to do
+//   **/*.c           last component is matched while the entries go by
+//   **/src/x.c       one openat/fstatat, the directory isn't read again
+//   **/*/x           the directory is opened again for walk()
+void FileGlob::walkTree(const std::vector<Component> &components, size_t index, int dirFd,
+                        const std::string &prefix, std::vector<std::string> &paths,
+                        GlobPool *pool, unsigned worker) {
+
+  bool last = index + 1 == components.size();
+  const Component *next = last ? NULL : &components[index + 1];
+  bool matchHere = next != NULL && index + 2 == components.size() && next->pattern._wildcard && !next->globstar;
+
+  struct Frame {
+    int fd;
+    bool owned;          // opened here (the first one is the caller's)
+    size_t pathLength;   // 'path' up to this directory
+    dev_t dev;
+    ino_t ino;
+    std::vector<char> buffer;
+    long size;
+    long offset;
+    off_t resume;        // directory offset after 'buffer', to reopen it
+  };
+  std::vector<Frame> stack;
+  std::string path = prefix;
+
+  // src/** has src/ itself
+  if (last && !prefix.empty()) {
+    paths.push_back(prefix);
+  }
+
+  // Still out of descriptors (low ulimit -n): the directories between the
+  // top one and the current one let go of theirs, they are opened again by
+  // path on the way back up
+  auto releaseAncestors = [&]() {
+    bool released = false;
+    for (size_t k = 1; k + 1 < stack.size(); k++) {
+      if (stack[k].owned && stack[k].fd >= 0) {
+        close(stack[k].fd);
+        stack[k].fd = -1;
+        released = true;
+      }
+    }
+    return released;
+  };
+
+  // New directory: the rest of the pattern first, then read it. False if
+  // it is already being walked
+  auto enter = [&](int fd, bool owned) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      return false;
+    }
+    for (auto & frame : stack) {
+      if (frame.dev == st.st_dev && frame.ino == st.st_ino) {
+        return false;
+      }
+    }
+
+    if (next != NULL && !matchHere) {
+      if (!next->pattern._wildcard) {
+        // Only openat/fstatat on fd, its offset isn't touched
+        walk(components, index + 1, fd, path, paths, pool, worker);
+      }
+      else {
+        // walk() reads the directory, with its own offset
+        int again = openat(fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (again < 0 && (errno == EMFILE || errno == ENFILE) && releaseAncestors()) {
+          again = openat(fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        }
+        if (again < 0) {
+          openError(path.c_str(), ".");
+        }
+        else {
+          walk(components, index + 1, again, path, paths, pool, worker);
+          close(again);
+        }
+      }
+    }
+
+    stack.push_back(Frame{ fd, owned, path.size(), st.st_dev, st.st_ino,
+                           std::vector<char>(GLOBSTAR_BUFFER), 0, 0, 0 });
+
+    // Deep tree: the level OPEN_LEVELS up doesn't need its descriptor for a while
+    if (stack.size() > OPEN_LEVELS) {
+      Frame &above = stack[stack.size() - 1 - OPEN_LEVELS];
+      if (above.owned && above.fd >= 0) {
+        close(above.fd);
+        above.fd = -1;
+      }
+    }
+    return true;
+  };
+
+  enter(dirFd, false);
+
+  while (!stack.empty()) {
+
+    Frame &frame = stack.back();
+
+    if (frame.fd < 0) {
+      std::string relative = path.substr(prefix.size(), frame.pathLength - prefix.size());
+      frame.fd = openat(dirFd, relative.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (frame.fd < 0 || lseek(frame.fd, frame.resume, SEEK_SET) != frame.resume) {
+        openError(path.substr(0, frame.pathLength).c_str(), "");
+        if (frame.fd >= 0) {
+          close(frame.fd);
+        }
+        stack.pop_back();
+        continue;
+      }
+    }
+
+    if (frame.offset >= frame.size) {
+      frame.size = syscall(SYS_getdents64, frame.fd, frame.buffer.data(), frame.buffer.size());
+      frame.offset = 0;
+      frame.resume = lseek(frame.fd, 0, SEEK_CUR);
+      if (frame.size <= 0) {
+        if (frame.owned) {
+          close(frame.fd);
+        }
+        stack.pop_back();
+        continue;
+      }
+    }
+
+    LinuxDirent64 *entry = (LinuxDirent64 *) (frame.buffer.data() + frame.offset);
+    frame.offset += entry->d_reclen;
+    path.resize(frame.pathLength);
+
+    const char *name = entry->d_name;
+    if (!strcmp(name, ".") || !strcmp(name, "..")) {
+      continue;
+    }
+    bool hidden = name[0] == '.';
+
+    if (matchHere && (!hidden || next->dot) && next->pattern.match(name, strlen(name))) {
+      paths.push_back(path + name);
+    }
+
+    // Hidden directories are not gone into
+    if (hidden) {
+      continue;
+    }
+    if (last) {
+      paths.push_back(path + name);
+    }
+
+    unsigned char type = entry->d_type;
+    if (type == DT_UNKNOWN) {
+      struct stat st;
+      type = fstatat(frame.fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+    }
+    if (type != DT_DIR) {
+      continue;
+    }
+
+    int fd = openat(frame.fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0 && (errno == EMFILE || errno == ENFILE) && releaseAncestors()) {
+      fd = openat(frame.fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    }
+    if (fd < 0) {
+      openError(path.c_str(), name);
+      continue;
+    }
+    path += name;
+    path += '/';
+    if (!enter(fd, true)) {
+      close(fd);
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef fileglob_hh
+#define fileglob_hh
+
+#include <string>
+#include <vector>
+
+#include "glob.hh"
+
+
+
+// Filename expansion: src/*/test?.c
+// The path is cut at the slashes once and every component with a wildcard
+// is compiled once (GlobPattern), the same compiled component is then used
+// in every directory the walk goes through.
+// Directories are read with getdents64 and opened with openat() relative to
+// their parent, d_type tells which entries are directories without a stat.
+// When the pattern goes through several levels of directories (logs/*/*/*.gz)
+// sibling directories are read by a small pool of threads (GLOB_THREADS,
+// default one per core up to 8, 1 turns it off). The threads only start
+// once the walk has found enough directories to share.
+// A ** component matches any number of directories (src/**/*.c), that part
+// of the tree is walked with an explicit stack, not by recursion.
+// With GLOB_CACHE set, listings come from DirCache (dirCache.cc) when the
+// directory hasn't changed.
+
+struct GlobPool;
+
+struct FileGlob {
+
+  // One piece of the path between slashes
+  struct Component {
+    GlobPattern pattern; // !_wildcard: a plain name, pattern._text is it unescaped
+    bool dot;            // starts with '.', may match hidden names
+    bool globstar;       // exactly **
+  };
+
+  // Adds the matching paths to 'paths' (not sorted).
+  // Returns false if nothing matched
+  static bool expand(const std::string &pattern, std::vector<std::string> &paths);
+
+  // std::sort order, big results are sorted in pieces by the threads and merged
+  static void sort(std::vector<std::string> &paths);
+
+  // GLOB_THREADS
+  static unsigned threads();
+
+private:
+  // 'pool' is NULL when there are no threads, otherwise subdirectories are
+  // handed to it and 'worker' is the thread doing this one
+  static void walk(const std::vector<Component> &components, size_t index, int dirFd,
+                   const std::string &prefix, std::vector<std::string> &paths,
+                   GlobPool *pool, unsigned worker);
+  static void walkTree(const std::vector<Component> &components, size_t index, int dirFd,
+                       const std::string &prefix, std::vector<std::string> &paths,
+                       GlobPool *pool, unsigned worker);
+  static void work(GlobPool *pool, unsigned worker);
+  static void startHelpers(GlobPool *pool);
+
+  friend struct GlobPool;
+};
+
+#endif
@@ -0,0 +1,197 @@
+#include <cstring>
+
+#include "glob.hh"
+
+
+
+void GlobPattern::compile(const char *pattern, size_t length) {
+
+  _steps.clear();
+  _text.clear();
+  _wildcard = false;
+
+  GlobStep step;
+  size_t i = 0;
+  while (i < length) {
+
+    char c = pattern[i];
+
+    if (c == '*') {
+      // ** is the same as *
+      if (_steps.empty() || _steps.back().kind != GlobStep::STAR) {
+        step.kind = GlobStep::STAR;
+        _steps.push_back(step);
+      }
+      _wildcard = true;
+      i++;
+      continue;
+    }
+
+    if (c == '?') {
+      step.kind = GlobStep::ANY;
+      _steps.push_back(step);
+      _wildcard = true;
+      i++;
+      continue;
+    }
+
+    if (c == '[') {
+      // Find the closing ], a ] right after [ or [! is part of the set
+      size_t end = i + 1;
+      if (end < length && (pattern[end] == '!' || pattern[end] == '^')) {
+        end++;
+      }
+      if (end < length && pattern[end] == ']') {
+        end++;
+      }
+      while (end < length && pattern[end] != ']') {
+        end++;
+      }
+
+      if (end < length) {
+        step.kind = GlobStep::CLASS;
+        memset(step.set, 0, sizeof(step.set));
+        size_t k = i + 1;
+        step.negate = pattern[k] == '!' || pattern[k] == '^';
+        if (step.negate) {
+          k++;
+        }
+        while (k < end) {
+          unsigned char from = pattern[k];
+          unsigned char to = from;
+          if (k + 2 < end && pattern[k + 1] == '-') {
+            to = pattern[k + 2];
+            k += 2;
+          }
+          for (unsigned ch = from; ch <= to; ch++) {
+            step.set[ch >> 3] |= 1 << (ch & 7);
+          }
+          k++;
+        }
+        _steps.push_back(step);
+        _wildcard = true;
+        i = end + 1;
+        continue;
+      }
+      // No closing ]: just a [
+    }
+
+    // Literal char (\x is always literal), glued to the previous literal
+    if (c == '\\' && i + 1 < length) {
+      i++;
+      c = pattern[i];
+    }
+    if (_steps.empty() || _steps.back().kind != GlobStep::LITERAL) {
+      step.kind = GlobStep::LITERAL;
+      step.start = _text.size();
+      step.length = 0;
+      _steps.push_back(step);
+    }
+    _text += c;
+    _steps.back().length++;
+    i++;
+  }
+
+  // What the fast rejects in match() need
+  _minLength = 0;
+  for (auto & step : _steps) {
+    _minLength += step.kind == GlobStep::LITERAL ? step.length : step.kind != GlobStep::STAR;
+  }
+  _prefix = !_steps.empty() && _steps.front().kind == GlobStep::LITERAL ? _steps.front().length : 0;
+  _suffix = _steps.size() > 1 && _steps.back().kind == GlobStep::LITERAL ? _steps.back().length : 0;
+}
+
+
+
+bool GlobPattern::match(const char *s, size_t length) const {
+
+  // Plain string
+  if (!_wildcard) {
+    return length == _text.size() && memcmp(s, _text.data(), length) == 0;
+  }
+
+  // Cheap rejects, most names fail here
+  if (length < _minLength) {
+    return false;
+  }
+  if (_prefix > 0 && memcmp(s, _text.data(), _prefix) != 0) {
+    return false;
+  }
+  if (_suffix > 0 && memcmp(s + length - _suffix, _text.data() + _text.size() - _suffix, _suffix) != 0) {
+    return false;
+  }
+
+  size_t si = 0;
+  size_t pi = 0;
+  size_t starStep = (size_t) -1; // step after the last * seen
+  size_t starPos = 0;            // where that * currently stops
+
+  for (;;) {
+
+    if (pi < _steps.size()) {
+      const GlobStep &step = _steps[pi];
+      bool ok = false;
+
+      switch (step.kind) {
+        case GlobStep::STAR:
+          if (pi + 1 == _steps.size()) {
+            return true; // trailing * eats the rest
+          }
+          starStep = ++pi;
+          starPos = si;
+          continue;
+
+        case GlobStep::LITERAL:
+          if (si + step.length <= length && memcmp(s + si, _text.data() + step.start, step.length) == 0) {
+            si += step.length;
+            ok = true;
+          }
+          break;
+
+        case GlobStep::ANY:
+          if (si < length) {
+            si++;
+            ok = true;
+          }
+          break;
+
+        case GlobStep::CLASS:
+          if (si < length) {
+            unsigned char ch = s[si];
+            bool in = (step.set[ch >> 3] >> (ch & 7)) & 1;
+            if (in != step.negate) {
+              si++;
+              ok = true;
+            }
+          }
+          break;
+      }
+
+      if (ok) {
+        pi++;
+        continue;
+      }
+    }
+    else if (si == length) {
+      return true;
+    }
+
+    // Mismatch: let the last * take one more char
+    if (starStep == (size_t) -1 || starPos >= length) {
+      return false;
+    }
+    si = ++starPos;
+    pi = starStep;
+
+    // * followed by a literal: jump to where its first char shows up next
+    // (memchr, glibc does it 16/32 bytes at a time)
+    const GlobStep &next = _steps[starStep];
+    if (next.kind == GlobStep::LITERAL) {
+      const char *hit = (const char *) memchr(s + si, _text[next.start], length - si);
+      if (hit == NULL) {
+        return false;
+      }
+      si = starPos = hit - s;
+    }
+  }
+}
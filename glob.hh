@@ -0,0 +1,44 @@
+#ifndef glob_hh
+#define glob_hh
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+/* Compiled glob pattern: * ? [abc] [a-z] [!x] and \x
+ * The pattern is turned into a list of steps once, match() then walks
+ * them with the usual "back up to the last *" loop: no recursion, no regex,
+ * nothing allocated while matching.
+ * Most names a filename glob sees don't match, so match() first checks the
+ * minimum length and the literal prefix/suffix (*.c, log-*) with memcmp.
+ */
+
+struct GlobStep {
+  enum Kind { LITERAL, ANY, STAR, CLASS };
+  Kind kind;
+  size_t start;           // LITERAL: chars _text[start, start + length)
+  size_t length;
+  bool negate;            // CLASS: [!...]
+  unsigned char set[32];  // CLASS: one bit per char
+};
+
+struct GlobPattern {
+  std::vector<GlobStep> _steps;
+  std::string _text;      // the literal chars of every LITERAL step
+  bool _wildcard;         // false: the pattern is just a string
+  size_t _minLength;      // shortest string that can match
+  size_t _prefix;         // length of the literal the pattern starts with
+  size_t _suffix;         // length of the literal it ends with (after a wildcard)
+
+  GlobPattern() : _wildcard(false), _minLength(0), _prefix(0), _suffix(0) {}
+  GlobPattern(const char *pattern, size_t length) { compile(pattern, length); }
+
+  void compile(const char *pattern, size_t length);
+
+  // Does the whole of s[0, length) match?
+  bool match(const char *s, size_t length) const;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <cstring>
+#include <pwd.h>
+#include <sys/stat.h>
+
+#include "homeCache.hh"
+
+std::unordered_map<std::string, std::string> HomeCache::_table;
+dev_t HomeCache::_dev = 0;
+ino_t HomeCache::_ino = 0;
+struct timespec HomeCache::_mtime;
+off_t HomeCache::_size = -1;
+
+
+
+// One stat() per lookup, still nothing compared to a trip through NSS.
+// Editors and useradd replace the file, so the inode is checked as well
+bool HomeCache::passwdChanged() {
+
+  struct stat st;
+  if (stat("/etc/passwd", &st) < 0) {
+    memset(&st, 0, sizeof(st));
+  }
+
+  bool changed = st.st_dev != _dev || st.st_ino != _ino || st.st_size != _size ||
+                 st.st_mtim.tv_sec != _mtime.tv_sec || st.st_mtim.tv_nsec != _mtime.tv_nsec;
+
+  _dev = st.st_dev;
+  _ino = st.st_ino;
+  _size = st.st_size;
+  _mtime = st.st_mtim;
+  return changed;
+}
+
+
+
+const char *HomeCache::lookup(const std::string &user) {
+
+  if (passwdChanged()) {
+    _table.clear();
+  }
+
+  auto found = _table.find(user);
+  if (found == _table.end()) {
+    struct passwd *pw = getpwnam(user.c_str());
+    found = _table.emplace(user, pw != NULL && pw->pw_dir != NULL ? pw->pw_dir : "").first;
+  }
+
+  if (found->second.empty()) {
+    return NULL;
+  }
+  return found->second.c_str();
+}
@@ -0,0 +1,33 @@
+#ifndef homecache_hh
+#define homecache_hh
+
+#include <string>
+#include <unordered_map>
+#include <sys/types.h>
+
+
+
+// Cache of ~user --> home directory
+// getpwnam() goes through NSS (sssd, LDAP...) and can take milliseconds,
+// so every user is only looked up once per session. Users that don't exist
+// are remembered too. Everything is forgotten when /etc/passwd changes.
+
+struct HomeCache {
+
+  // user --> home directory, "" if there is no such user
+  static std::unordered_map<std::string, std::string> _table;
+
+  // /etc/passwd when the table was filled
+  static dev_t _dev;
+  static ino_t _ino;
+  static struct timespec _mtime;
+  static off_t _size;
+
+  // Home directory of 'user', NULL if there is no such user
+  static const char *lookup(const std::string &user);
+
+private:
+  static bool passwdChanged();
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <spawn.h>
+#include <unistd.h>
+
+#include "launch.hh"
+#include "variables.hh"
+
+// close_range() and posix_spawn_file_actions_addclosefrom_np() showed up in glibc 2.34.
+// Older systems just rely on every shell descriptor being O_CLOEXEC.
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#define HAVE_CLOSEFROM
+#endif
+
+LaunchMode Launcher::_mode = LAUNCH_SPAWN;
+
+
+
+void Launcher::init() {
+
+  // SHELL_LAUNCH=fork goes back to fork() + execvp() for every command.
+  // Handy to compare the two paths, e.g:
+  //   time (yes 'true' | head -10000 | SHELL_LAUNCH=fork ./shell)
+  //   time (yes 'true' | head -10000 | SHELL_LAUNCH=spawn ./shell)
+  const char *mode = Variables::get("SHELL_LAUNCH");
+  if (mode != NULL && !strcmp(mode, "fork")) {
+    _mode = LAUNCH_FORK;
+  }
+}
+
+
+
+/* Start a command without copying the shell.
+ * glibc's posix_spawn uses clone(CLONE_VM|CLONE_VFORK), so the child runs on
+ * our memory until it calls exec. Nothing gets copied no matter how big the
+ * shell has grown (history, environment, sourced scripts...).
+ * The redirections are done by file actions inside the child, the shell's
+ * own 0/1/2 are never touched.
+ */
+pid_t Launcher::spawn(const char *path, char **args, const FdPlan &plan) {
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+
+  // Only dup2 what is actually redirected
+  if (plan.in != 0) {
+    posix_spawn_file_actions_adddup2(&actions, plan.in, 0);
+  }
+  if (plan.out != 1) {
+    posix_spawn_file_actions_adddup2(&actions, plan.out, 1);
+  }
+  if (plan.err != 2) {
+    posix_spawn_file_actions_adddup2(&actions, plan.err, 2);
+  }
+
+#ifdef HAVE_CLOSEFROM
+  // Anything the shell inherited without O_CLOEXEC
+  posix_spawn_file_actions_addclosefrom_np(&actions, plan.closeFrom);
+#endif
+
+  pid_t pid;
+  int err = posix_spawn(&pid, path, &actions, NULL, args, Variables::envp());
+  posix_spawn_file_actions_destroy(&actions);
+
+  // posix_spawn reports exec failures (EACCES, ENOEXEC...) back to the parent
+  if (err != 0) {
+    dprintf(plan.err, "%s: %s\n", args[0], strerror(err));
+    errno = err;
+    return -1;
+  }
+
+  return pid;
+}
+
+
+
+void Launcher::applyPlan(const FdPlan &plan) {
+
+  // dup2 clears O_CLOEXEC on the new descriptor
+  if (plan.in != 0) {
+    dup2(plan.in, 0);
+  }
+  if (plan.out != 1) {
+    dup2(plan.out, 1);
+  }
+  if (plan.err != 2) {
+    dup2(plan.err, 2);
+  }
+
+#ifdef HAVE_CLOSEFROM
+  close_range(plan.closeFrom, ~0U, 0);
+#endif
+}
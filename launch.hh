@@ -0,0 +1,39 @@
+#ifndef launch_hh
+#define launch_hh
+
+#include <sys/types.h>
+
+
+
+// How external commands get started
+// SPAWN: posix_spawn (clone with CLONE_VM|CLONE_VFORK, no page table copy)
+// FORK:  the old fork() + execvp() path
+enum LaunchMode { LAUNCH_SPAWN, LAUNCH_FORK };
+
+// Where one pipeline stage's stdin/stdout/stderr come from.
+// Computed by Command::execute(), applied only in the child.
+struct FdPlan {
+  int in;
+  int out;
+  int err;
+  int closeFrom; // 3, or past the /dev/fd/N of process substitutions
+};
+
+struct Launcher {
+
+  // Mode used for external commands, spawn by default
+  static LaunchMode _mode;
+
+  // Read SHELL_LAUNCH=fork|spawn from the environment (used for benchmarking)
+  static void init();
+
+  // Start the program at 'path' (already resolved, see PathCache) with posix_spawn.
+  // The plan is turned into file actions.
+  // Returns the pid, or -1 (errno set) if the command could not be started.
+  static pid_t spawn(const char *path, char **args, const FdPlan &plan);
+
+  // Same plan for a forked child: dup2 into 0/1/2 and close everything else
+  static void applyPlan(const FdPlan &plan);
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+
+#include "pathCache.hh"
+#include "variables.hh"
+
+std::unordered_map<std::string, std::string> PathCache::_table;
+int PathCache::_inotifyFd = -1;
+
+
+
+/* Watch every $PATH directory with inotify.
+ * If anything gets created, deleted or renamed in one of them the cached
+ * paths may be wrong (new command earlier in PATH, command removed...),
+ * so the next lookup throws the whole table away.
+ */
+void PathCache::watchPath() {
+
+  const char *path = Variables::get("PATH");
+  if (path == NULL) {
+    return;
+  }
+
+  _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_inotifyFd < 0) {
+    return; // No inotify, lookup() checks the cached file instead
+  }
+
+  uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                  IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+
+  std::string dirs = path;
+  size_t start = 0;
+  while (start <= dirs.size()) {
+    size_t end = dirs.find(':', start);
+    if (end == std::string::npos) {
+      end = dirs.size();
+    }
+    std::string dir = dirs.substr(start, end - start);
+    if (!dir.empty() && dir[0] == '/') {
+      inotify_add_watch(_inotifyFd, dir.c_str(), mask);
+    }
+    start = end + 1;
+  }
+}
+
+
+
+// Drain the inotify queue, true if any $PATH directory changed
+bool PathCache::pathChanged() {
+
+  char buf[4096];
+  bool changed = false;
+  while (read(_inotifyFd, buf, sizeof(buf)) > 0) {
+    changed = true;
+  }
+  return changed;
+}
+
+
+
+const char *PathCache::lookup(const char *name) {
+
+  // Paths are used as they are: ./a.out, /bin/ls ...
+  if (strchr(name, '/') != NULL) {
+    return name;
+  }
+
+  if (_inotifyFd >= 0 && pathChanged()) {
+    invalidate();
+  }
+
+  auto found = _table.find(name);
+  if (found != _table.end()) {
+
+    // Without inotify make sure the file is still there
+    if (_inotifyFd >= 0 || access(found->second.c_str(), X_OK) == 0) {
+      return found->second.c_str();
+    }
+    _table.erase(found);
+  }
+
+  const char *path = Variables::get("PATH");
+  if (path == NULL) {
+    return NULL;
+  }
+
+  // Start watching before the search so nothing is missed in between
+  if (_inotifyFd < 0 && _table.empty()) {
+    watchPath();
+  }
+
+  // Same search execvp does: first executable regular file wins
+  std::string dirs = path;
+  size_t start = 0;
+  while (start <= dirs.size()) {
+    size_t end = dirs.find(':', start);
+    if (end == std::string::npos) {
+      end = dirs.size();
+    }
+
+    // Empty entry means current directory
+    std::string dir = dirs.substr(start, end - start);
+    if (dir.empty()) {
+      dir = ".";
+    }
+    std::string full = dir + "/" + name;
+
+    struct stat st;
+    if (stat(full.c_str(), &st) == 0 && S_ISREG(st.st_mode) &&
+        access(full.c_str(), X_OK) == 0) {
+
+      // Relative entries depend on the cwd, don't remember them
+      if (dir[0] != '/') {
+        static std::string relative;
+        relative = full;
+        return relative.c_str();
+      }
+      return _table.emplace(name, full).first->second.c_str();
+    }
+    start = end + 1;
+  }
+
+  return NULL;
+}
+
+
+
+void PathCache::invalidate() {
+
+  _table.clear();
+
+  // PATH itself may have changed, watch again on the next lookup
+  if (_inotifyFd >= 0) {
+    close(_inotifyFd);
+    _inotifyFd = -1;
+  }
+}
+
+
+
+void PathCache::print() {
+  for (auto & entry : _table) {
+    printf("%s\t%s\n", entry.first.c_str(), entry.second.c_str());
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef pathcache_hh
+#define pathcache_hh
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+
+// Hash table of command name -> absolute path (like 'hash' in bash)
+// Saves searching every $PATH directory for each command we run.
+
+struct PathCache {
+
+  // name --> absolute path
+  static std::unordered_map<std::string, std::string> _table;
+
+  // inotify descriptor watching the $PATH directories (-1 if not available)
+  static int _inotifyFd;
+
+  // Find the absolute path of a command.
+  // Names with a '/' are returned as is.
+  // Returns NULL if the command is not in $PATH
+  static const char *lookup(const char *name);
+
+  // Forget everything (PATH changed, 'hash -r'...)
+  static void invalidate();
+
+  // Print the table for 'hash'
+  static void print();
+
+private:
+  static void watchPath();
+  static bool pathChanged();
+};
+
+#endif
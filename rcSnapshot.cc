@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "rcSnapshot.hh"
+#include "pathCache.hh"
+#include "variables.hh"
+
+#define SNAPSHOT_MAGIC "shellrc-snapshot 2\n"
+
+
+
+// FNV-1a over a string, continuing from 'h'
+static unsigned long long hashString(unsigned long long h, const char *s) {
+  for (; *s; s++) {
+    h = (h ^ (unsigned char)*s) * 1099511628211ULL;
+  }
+  // separator so "ab","c" and "a","bc" differ
+  return (h ^ 0xff) * 1099511628211ULL;
+}
+
+
+
+// Hash of the inherited environment and the starting directory:
+// .shellrc may produce something different if either changes
+unsigned long long RcSnapshot::startKey() {
+
+  unsigned long long h = 14695981039346656037ULL;
+  for (char **env = Variables::envp(); *env; env++) {
+    h = hashString(h, *env);
+  }
+
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) != NULL) {
+    h = hashString(h, cwd);
+  }
+  return h;
+}
+
+
+
+// First line of the snapshot: what it was made from
+static bool header(const char *rcFile, unsigned long long key, std::string &line) {
+
+  struct stat st;
+  if (stat(rcFile, &st) < 0) {
+    return false;
+  }
+
+  char buf[256];
+  snprintf(buf, sizeof(buf), "%llu %llu %lld %ld %lld %llu\n",
+           (unsigned long long) st.st_dev, (unsigned long long) st.st_ino,
+           (long long) st.st_mtim.tv_sec, (long) st.st_mtim.tv_nsec,
+           (long long) st.st_size, key);
+  line = buf;
+  return true;
+}
+
+
+
+bool RcSnapshot::load(const char *rcFile, const char *snapshotFile, unsigned long long key) {
+
+  std::string expected;
+  if (!header(rcFile, key, expected)) {
+    return false;
+  }
+
+  FILE *f = fopen(snapshotFile, "re");
+  if (f == NULL) {
+    return false;
+  }
+
+  // Whole file in one go
+  std::string data;
+  char buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.append(buf, n);
+  }
+  fclose(f);
+
+  // magic, header, then cwd and variables separated by NULs. A variable is
+  // "x" (exported) or "-" (shell only), then name=value
+  std::string prefix = SNAPSHOT_MAGIC + expected;
+  if (data.compare(0, prefix.size(), prefix) != 0) {
+    return false; // .shellrc or the starting state changed
+  }
+
+  size_t pos = prefix.size();
+  size_t end = data.find('\0', pos);
+  if (end == std::string::npos) {
+    return false;
+  }
+  std::string cwd = data.substr(pos, end - pos);
+  pos = end + 1;
+
+  // Replace the variables with the snapshot's
+  Variables::clear();
+  while (pos < data.size()) {
+    end = data.find('\0', pos);
+    if (end == std::string::npos) {
+      break;
+    }
+    std::string entry = data.substr(pos, end - pos);
+    size_t eq = entry.find('=');
+    if (entry.size() > 1 && eq != std::string::npos) {
+      Variables::set(entry.substr(1, eq - 1).c_str(), entry.substr(eq + 1).c_str(), entry[0] == 'x');
+    }
+    pos = end + 1;
+  }
+
+  if (chdir(cwd.c_str()) < 0) {
+    perror("rc snapshot: chdir");
+  }
+
+  PathCache::invalidate();
+  return true;
+}
+
+
+
+void RcSnapshot::save(const char *rcFile, const char *snapshotFile, unsigned long long key) {
+
+  // Only plain variables go in a snapshot, an rc file that makes arrays
+  // has to run every time
+  if (!Variables::_arrays.empty()) {
+    return;
+  }
+
+  std::string data = SNAPSHOT_MAGIC;
+  std::string line;
+  if (!header(rcFile, key, line)) {
+    return;
+  }
+  data += line;
+
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    return;
+  }
+  data += cwd;
+  data += '\0';
+
+  // Exported or not, $((n = 1)) and ${v:=x} make shell only ones
+  std::vector<const Variables::Variable *> variables;
+  Variables::list(variables);
+  for (auto v : variables) {
+    data += v->exported ? 'x' : '-';
+    data += v->text;
+    data += '\0';
+  }
+
+  // Write a temp file and rename it, shells starting at the same time
+  // never see half a snapshot
+  std::string tmp = std::string(snapshotFile) + "." + std::to_string(getpid());
+  int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return;
+  }
+  bool ok = write(fd, data.data(), data.size()) == (ssize_t) data.size();
+  close(fd);
+
+  if (!ok || rename(tmp.c_str(), snapshotFile) < 0) {
+    unlink(tmp.c_str());
+  }
+}
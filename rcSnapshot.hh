@@ -0,0 +1,33 @@
+#ifndef rcsnapshot_hh
+#define rcsnapshot_hh
+
+#include <sys/types.h>
+
+
+
+/* Snapshot of what .shellrc leaves behind (opt-in)
+ * After .shellrc runs, the variables and current directory are written to
+ * a snapshot file. The next shell that starts with the same .shellrc (dev,
+ * inode, mtime, size), the same inherited environment and the same starting
+ * directory loads the snapshot instead of lexing and running .shellrc.
+ *
+ * Only the variables (exported or not) and the directory are restored, not
+ * arrays (an rc file with arrays isn't snapshotted). Anything else
+ * .shellrc does (printing, creating files...) is skipped when the snapshot
+ * is used. Enabled with --rc-snapshot or SHELL_RC_SNAPSHOT=1 (inherited by
+ * child shells, which is where it pays off).
+ */
+
+struct RcSnapshot {
+
+  // Key of the starting state, taken before .shellrc runs
+  static unsigned long long startKey();
+
+  // Apply the snapshot if it matches, returns false if .shellrc must run
+  static bool load(const char *rcFile, const char *snapshotFile, unsigned long long key);
+
+  // Write the current environment and directory as the snapshot
+  static void save(const char *rcFile, const char *snapshotFile, unsigned long long key);
+};
+
+#endif
@@ -5,8 +5,15 @@ extern int yydebug;
 #include <cstdio>
 #include <unistd.h>
 #include "shell.hh"
+#include "launch.hh"
+#include "rcSnapshot.hh"
+#include "variables.hh"
 #include <signal.h>
 #include <sys/wait.h>
+#include <time.h>
+#include <limits.h>
+#include <string>
+#include <cstring>
 #include<stdlib.h>
 
 
@@ -32,7 +39,7 @@ void ctrl_c(int signal) {
 }
 
 void Shell::prompt() {
-  if (isatty(0)) {
+  if (isatty(0) && !_isSubshell) {
     printf("myshell>");
   }
   fflush(stdout);
@@ -46,7 +53,50 @@ void zombie(int signal) {
 
 
 
-int main(int, char **argv) {
+// --startup-trace: time spent in each startup phase, printed to stderr
+static bool startup_trace = false;
+static struct timespec trace_start, trace_last;
+
+static double ms_between(const struct timespec &a, const struct timespec &b) {
+  return (b.tv_sec - a.tv_sec) * 1000.0 + (b.tv_nsec - a.tv_nsec) / 1e6;
+}
+
+static void trace_phase(const char *phase) {
+  if (!startup_trace) {
+    return;
+  }
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  fprintf(stderr, "startup: %-24s %9.3f ms\n", phase, ms_between(trace_last, now));
+  trace_last = now;
+}
+
+
+
+int main(int argc, char **argv) {
+
+  clock_gettime(CLOCK_MONOTONIC, &trace_start);
+  trace_last = trace_start;
+
+  // Shell variables start as a copy of the environment
+  Variables::init();
+
+  // Startup options
+  // --startup-trace  print how long each startup phase took
+  // --rc-snapshot    use/refresh the .shellrc snapshot (same as SHELL_RC_SNAPSHOT=1)
+  bool rc_snapshot = false;
+  const char *snapshot_env = Variables::get("SHELL_RC_SNAPSHOT");
+  if (snapshot_env != NULL && !strcmp(snapshot_env, "1")) {
+    rc_snapshot = true;
+  }
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--startup-trace")) {
+      startup_trace = true;
+    }
+    else if (!strcmp(argv[i], "--rc-snapshot")) {
+      rc_snapshot = true;
+    }
+  }
 
   // Set up Ctrl handler
   struct sigaction sa;
@@ -73,29 +123,64 @@ int main(int, char **argv) {
     exit(2);
   }
 
-
+  trace_phase("signals");
 
 
   // Variable expanions: ${SHELL} --> prints path of shell executable
   // Rest of this handled in shell.l
   char *path = argv[0]; // gets the first arg (program itself)
   char *gustavo = realpath(path, NULL);
-  setenv("SHELL", gustavo, 1);
+  Variables::set("SHELL", gustavo, true);
   free(gustavo);
+  trace_phase("realpath(argv[0])");
+
+  // Pick how external commands are launched (spawn unless SHELL_LAUNCH=fork)
+  Launcher::init();
+  trace_phase("launcher");
 
 
   /* Extra credit 2.7 */
-  // Attempt to open the .shellsrc file
-  FILE *file = fopen(".shellrc", "r");
-  if (file) {
-    yyrestart(file); // tell lex to read from 'file' and not stdin
-    yyparse(); // parse the file
-    yyrestart(stdin); // Go back to reading from terminal
-    fclose(file);
-    file = NULL;
+  // With the snapshot on, a matching .shellrc.snapshot replaces running .shellrc
+  // (paths made absolute first, .shellrc may well cd somewhere else)
+  unsigned long long start_key = 0;
+  std::string rc_path = ".shellrc", snapshot_path = ".shellrc.snapshot";
+  if (rc_snapshot) {
+    start_key = RcSnapshot::startKey();
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) != NULL) {
+      rc_path = std::string(cwd) + "/.shellrc";
+      snapshot_path = std::string(cwd) + "/.shellrc.snapshot";
+    }
+  }
+  if (rc_snapshot && RcSnapshot::load(rc_path.c_str(), snapshot_path.c_str(), start_key)) {
+    trace_phase(".shellrc snapshot");
+    Shell::prompt();
   }
   else {
-    Shell::prompt(); // prompt user, 'file' no existo
+    // Attempt to open the .shellsrc file
+    FILE *file = fopen(".shellrc", "r");
+    if (file) {
+      yyrestart(file); // tell lex to read from 'file' and not stdin
+      yyparse(); // parse the file
+      yyrestart(stdin); // Go back to reading from terminal
+      fclose(file);
+      file = NULL;
+      trace_phase(".shellrc");
+
+      if (rc_snapshot) {
+        RcSnapshot::save(rc_path.c_str(), snapshot_path.c_str(), start_key);
+        trace_phase(".shellrc snapshot save");
+      }
+    }
+    else {
+      Shell::prompt(); // prompt user, 'file' no existo
+    }
+  }
+
+  if (startup_trace) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    fprintf(stderr, "startup: %-24s %9.3f ms\n", "total", ms_between(trace_start, now));
   }
 
 
@@ -110,3 +195,5 @@ int main(int, char **argv) {
 Command Shell::_currentCommand;
 
 std::string Shell::last_arg = "";
+
+bool Shell::_isSubshell = false;
@@ -13,6 +13,9 @@ struct Shell {
 
   static std::string last_arg;
 
+  // True in the child running a $(...), never prompts
+  static bool _isSubshell;
+
 };
 
 #endif
@@ -1,30 +1,52 @@
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <iostream>
 
 #include "simpleCommand.hh"
 
-SimpleCommand::SimpleCommand() {
-  _arguments = std::vector<std::string *>();
+SimpleCommand::SimpleCommand( Arena * arena )
+  : _buffer(ArenaAllocator<char>(arena)),
+    _offsets(ArenaAllocator<size_t>(arena)),
+    _argv(ArenaAllocator<char *>(arena)) {
 }
 
 SimpleCommand::~SimpleCommand() {
-  // iterate over all the arguments and delete them
-  for (auto & arg : _arguments) {
-    delete arg;
-  }
+  // Nothing to free, the arena gets reset by Command::clear()
+}
+
+void SimpleCommand::insertArgument( const char * argument, size_t length ) {
+  // copy the argument and its NUL at the end of the buffer
+  _offsets.push_back(_buffer.size());
+  _buffer.insert(_buffer.end(), argument, argument + length);
+  _buffer.push_back('\0');
+}
+
+void SimpleCommand::insertArgument( const std::string & argument ) {
+  insertArgument(argument.c_str(), argument.size());
+}
+
+void SimpleCommand::insertArgument( const char * argument ) {
+  insertArgument(argument, strlen(argument));
 }
 
-void SimpleCommand::insertArgument( std::string * argument ) {
-  // simply add the argument to the vector
-  _arguments.push_back(argument);
+char ** SimpleCommand::argv() {
+  // Arguments were added since the last call (and the buffer may have moved)
+  if (_argv.size() != _offsets.size() + 1) {
+    _argv.clear();
+    for (size_t offset : _offsets) {
+      _argv.push_back(&_buffer[offset]);
+    }
+    _argv.push_back(NULL);
+  }
+  return _argv.data();
 }
 
 // Print out the simple command
 void SimpleCommand::print() {
-  for (auto & arg : _arguments) {
-    std::cout << "\"" << (*arg) << "\" \t";
+  for (size_t i = 0; i < size(); i++) {
+    std::cout << "\"" << argument(i) << "\" \t";
   }
   // effectively the same as printf("\n\n");
   std::cout << std::endl;
@@ -1,18 +1,41 @@
-#ifndef simplcommand_hh
+#ifndef simplecommand_hh
 #define simplecommand_hh
 
 #include <string>
 #include <vector>
 
+#include "arena.hh"
+
 struct SimpleCommand {
 
-  // Simple command is simply a vector of strings
-  std::vector<std::string *> _arguments;
+  // All the arguments packed in one buffer, one after the other,
+  // each one NUL terminated: "ls\0-l\0*.txt\0"
+  // One allocation for the whole command instead of one per argument.
+  // Everything lives in the command's arena (see Command::_arena).
+  std::vector<char, ArenaAllocator<char> > _buffer;
+
+  // Where each argument starts in _buffer
+  std::vector<size_t, ArenaAllocator<size_t> > _offsets;
+
+  // Ready to use argv for exec (pointers into _buffer, NULL terminated).
+  // Rebuilt by argv() only after arguments were added.
+  std::vector<char *, ArenaAllocator<char *> > _argv;
 
-  SimpleCommand();
+  SimpleCommand( Arena * arena );
   ~SimpleCommand();
-  void insertArgument( std::string * argument );
+  void insertArgument( const char * argument, size_t length );
+  void insertArgument( const std::string & argument );
+  void insertArgument( const char * argument );
   void print();
+
+  // Number of arguments
+  size_t size() const { return _offsets.size(); }
+
+  // i-th argument
+  const char * argument( size_t i ) const { return &_buffer[_offsets[i]]; }
+
+  // NULL terminated argv, valid until the next insertArgument()
+  char ** argv();
 };
 
 #endif
@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "sourceCache.hh"
+#include "shell.hh"
+
+std::vector<SourceCache::Entry> SourceCache::_entries;
+std::vector<SavedCommand> *SourceCache::_recording = NULL;
+bool SourceCache::_uncacheable = false;
+
+
+
+static bool sameFile(const SourceCache::Entry &entry, const struct stat &st) {
+  return entry.dev == st.st_dev && entry.ino == st.st_ino &&
+         entry.size == st.st_size &&
+         entry.mtime.tv_sec == st.st_mtim.tv_sec &&
+         entry.mtime.tv_nsec == st.st_mtim.tv_nsec;
+}
+
+
+
+const SourceCache::Entry *SourceCache::find(const struct stat &st) {
+  for (auto & entry : _entries) {
+    if (sameFile(entry, st)) {
+      return &entry;
+    }
+  }
+  return NULL;
+}
+
+
+
+void SourceCache::record(Command &command) {
+
+  if (_recording == NULL || _uncacheable) {
+    return;
+  }
+
+  SavedCommand saved;
+  for (auto simpleCommand : command._simpleCommands) {
+    std::vector<std::string> args;
+    for (size_t i = 0; i < simpleCommand->size(); i++) {
+      args.push_back(simpleCommand->argument(i));
+    }
+    saved._simpleCommands.push_back(args);
+  }
+
+  saved._hasOut = command._outFile != NULL;
+  saved._hasIn = command._inFile != NULL;
+  saved._hasErr = command._errFile != NULL;
+  if (saved._hasOut) {
+    saved._outFile = command._outFile;
+  }
+  if (saved._hasIn) {
+    saved._inFile = command._inFile;
+  }
+  if (saved._hasErr) {
+    saved._errFile = command._errFile;
+  }
+  saved._background = command._background;
+  saved._outMode = command._outMode;
+
+  _recording->push_back(saved);
+}
+
+
+
+void SourceCache::store(const struct stat &st, std::vector<SavedCommand> &commands) {
+
+  // Older version of the same file
+  for (size_t i = 0; i < _entries.size(); i++) {
+    if (_entries[i].dev == st.st_dev && _entries[i].ino == st.st_ino) {
+      _entries.erase(_entries.begin() + i);
+      break;
+    }
+  }
+
+  // Full: drop the oldest one
+  if (_entries.size() >= MAX_ENTRIES) {
+    _entries.erase(_entries.begin());
+  }
+
+  Entry entry;
+  entry.dev = st.st_dev;
+  entry.ino = st.st_ino;
+  entry.mtime = st.st_mtim;
+  entry.size = st.st_size;
+  entry.commands.swap(commands);
+  _entries.push_back(entry);
+}
+
+
+
+void SourceCache::replay(const Entry &entry) {
+
+  // Copy, a nested 'source' may change _entries while we run
+  std::vector<SavedCommand> commands = entry.commands;
+
+  Command &command = Shell::_currentCommand;
+  Arena *arena = &command._arena;
+
+  for (auto & saved : commands) {
+    command.clear();
+
+    for (auto & args : saved._simpleCommands) {
+      SimpleCommand *simpleCommand = arena->create<SimpleCommand>(arena);
+      for (auto & arg : args) {
+        simpleCommand->insertArgument(arg);
+      }
+      command.insertSimpleCommand(simpleCommand);
+    }
+
+    if (saved._hasOut) {
+      command._outFile = arena->strdup(saved._outFile);
+    }
+    if (saved._hasIn) {
+      command._inFile = arena->strdup(saved._inFile);
+    }
+    if (saved._hasErr) {
+      command._errFile = arena->strdup(saved._errFile);
+    }
+    command._background = saved._background;
+    command._outMode = saved._outMode;
+
+    command.execute();
+  }
+}
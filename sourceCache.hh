@@ -0,0 +1,69 @@
+#ifndef sourcecache_hh
+#define sourcecache_hh
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "command.hh"
+
+
+
+/* Cache of parsed 'source' files
+ * The first time a file is sourced, every command table the parser builds
+ * is copied here before it runs. Sourcing the same unchanged file again
+ * (same dev, inode, mtime and size) replays those tables without lexing
+ * or parsing anything.
+ * Files whose commands needed expansions (${VAR}, $(...), ~, wildcards...)
+ * or had syntax errors are not cached, their result depends on when they run.
+ */
+
+// One command line, copied out of the arena so it survives Command::clear()
+struct SavedCommand {
+  std::vector<std::vector<std::string> > _simpleCommands;
+  std::string _outFile;
+  std::string _inFile;
+  std::string _errFile;
+  bool _hasOut;
+  bool _hasIn;
+  bool _hasErr;
+  bool _background;
+  Command::RedirectMode _outMode;
+};
+
+struct SourceCache {
+
+  struct Entry {
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    off_t size;
+    std::vector<SavedCommand> commands;
+  };
+
+  // Most files we keep
+  enum { MAX_ENTRIES = 64 };
+
+  static std::vector<Entry> _entries;
+
+  // Commands of the file being sourced right now (NULL if not sourcing)
+  static std::vector<SavedCommand> *_recording;
+
+  // Set when the file being sourced can't be cached
+  static bool _uncacheable;
+
+  // Cached commands for this file, or NULL
+  static const Entry *find(const struct stat &st);
+
+  // Called by the parser before each command runs
+  static void record(Command &command);
+
+  // Remember the commands recorded for this file
+  static void store(const struct stat &st, std::vector<SavedCommand> &commands);
+
+  // Run cached commands through Shell::_currentCommand
+  static void replay(const Entry &entry);
+};
+
+#endif
@@ -0,0 +1,19 @@
+#!/bin/bash
+# .shellrc runs exactly once at startup, then the shell reads stdin
+#
+#   tests/shellrc.sh [path/to/shell]
+
+SHELL_BIN=$(realpath "${1:-./shell}")
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+cd "$TMP"
+echo 'echo rc ran' > .shellrc
+output=$(echo 'echo main' | timeout 5 "$SHELL_BIN")
+
+if [ "$output" != "$(printf 'rc ran\nmain')" ]; then
+  echo "FAIL: .shellrc"
+  echo "$output" | head -5
+  exit 1
+fi
+echo "ok: .shellrc"
@@ -0,0 +1,358 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "variables.hh"
+#include "arith.hh"
+
+extern char **environ;
+extern int code;     // exit code of the last command (command.cc)
+extern int last_pid; // last background pid (command.cc)
+extern std::string last_arg; // last argument of the last command (command.cc)
+
+std::vector<Variables::Variable> Variables::_table;
+size_t Variables::_count = 0;
+size_t Variables::_used = 0;
+std::vector<char *> Variables::_envp;
+bool Variables::_envpDirty = true;
+std::unordered_map<std::string, Variables::Array> Variables::_arrays;
+
+// Marks a deleted slot, probing goes on past it
+static char deleted[] = "";
+
+static pid_t shell_pid;
+
+
+
+// FNV-1a
+static unsigned hashName(const char *name, size_t length) {
+  unsigned h = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    h = (h ^ (unsigned char) name[i]) * 16777619u;
+  }
+  return h;
+}
+
+
+
+void Variables::init() {
+
+  shell_pid = getpid();
+
+  _table.assign(64, Variable());
+
+  for (char **env = environ; *env; env++) {
+    const char *eq = strchr(*env, '=');
+    if (eq == NULL) {
+      continue;
+    }
+    std::string name(*env, eq - *env);
+    set(name.c_str(), eq + 1, true);
+  }
+}
+
+
+
+// Slot holding 'name', or the empty slot where it would go
+size_t Variables::slot(const char *name, size_t length, unsigned hash) {
+
+  size_t mask = _table.size() - 1;
+  size_t i = hash & mask;
+  size_t firstDeleted = (size_t) -1;
+
+  for (;;) {
+    Variable &v = _table[i];
+    if (v.text == NULL) {
+      return firstDeleted != (size_t) -1 ? firstDeleted : i;
+    }
+    if (v.text == deleted) {
+      if (firstDeleted == (size_t) -1) {
+        firstDeleted = i;
+      }
+    }
+    else if (v.hash == hash && v.nameLength == length && !memcmp(v.text, name, length)) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+}
+
+
+
+// Double the table (or just clean out deleted slots)
+void Variables::grow() {
+
+  std::vector<Variable> old;
+  old.swap(_table);
+
+  size_t size = old.size();
+  if (_count * 2 >= size) {
+    size *= 2;
+  }
+  _table.assign(size, Variable());
+  _used = _count;
+
+  size_t mask = size - 1;
+  for (auto & v : old) {
+    if (v.text == NULL || v.text == deleted) {
+      continue;
+    }
+    size_t i = v.hash & mask;
+    while (_table[i].text != NULL) {
+      i = (i + 1) & mask;
+    }
+    _table[i] = v;
+  }
+}
+
+
+
+const char *Variables::get(const char *name, size_t length) {
+
+  if (_table.empty()) {
+    return NULL;
+  }
+
+  Variable &v = _table[slot(name, length, hashName(name, length))];
+  if (v.text == NULL || v.text == deleted) {
+    return NULL;
+  }
+  return v.text + v.nameLength + 1;
+}
+
+
+
+void Variables::set(const char *name, const char *value, bool exported) {
+
+  if (_table.empty()) {
+    _table.assign(64, Variable());
+  }
+
+  // Keep the table at most 3/4 full, deleted slots included
+  if ((_used + 1) * 4 > _table.size() * 3) {
+    grow();
+  }
+
+  size_t length = strlen(name);
+  unsigned hash = hashName(name, length);
+  Variable &v = _table[slot(name, length, hash)];
+
+  bool existed = v.text != NULL && v.text != deleted;
+  if (existed) {
+    if (v.exported || exported) {
+      _envpDirty = true;
+    }
+    free(v.text);
+  }
+  else {
+    if (v.text == NULL) {
+      _used++;
+    }
+    _count++;
+    if (exported) {
+      _envpDirty = true;
+    }
+  }
+
+  size_t valueLength = strlen(value);
+  v.text = (char *) malloc(length + valueLength + 2);
+  if (v.text == NULL) {
+    perror("malloc");
+    exit(1);
+  }
+  memcpy(v.text, name, length);
+  v.text[length] = '=';
+  memcpy(v.text + length + 1, value, valueLength + 1);
+
+  v.nameLength = length;
+  v.hash = hash;
+  v.exported = exported || (existed && v.exported);
+}
+
+
+
+bool Variables::unset(const char *name) {
+
+  bool wasArray = _arrays.erase(name) > 0;
+
+  if (_table.empty()) {
+    return wasArray;
+  }
+
+  size_t length = strlen(name);
+  Variable &v = _table[slot(name, length, hashName(name, length))];
+  if (v.text == NULL || v.text == deleted) {
+    return wasArray;
+  }
+
+  if (v.exported) {
+    _envpDirty = true;
+  }
+  free(v.text);
+  v.text = deleted;
+  _count--;
+  return true;
+}
+
+
+
+void Variables::clear() {
+  for (auto & v : _table) {
+    if (v.text != NULL && v.text != deleted) {
+      free(v.text);
+    }
+    v.text = NULL;
+  }
+  _count = 0;
+  _used = 0;
+  _envpDirty = true;
+  _arrays.clear();
+}
+
+
+
+Variables::Array *Variables::array(const std::string &name) {
+  if (_arrays.empty()) {
+    return NULL;
+  }
+  auto found = _arrays.find(name);
+  return found != _arrays.end() ? &found->second : NULL;
+}
+
+
+
+Variables::Array &Variables::makeArray(const std::string &name, bool associative) {
+  unset(name.c_str());
+  Array &array = _arrays[name];
+  array.associative = associative;
+  return array;
+}
+
+
+
+// Subscript of an indexed array, negative ones count from the end
+bool Variables::index(const std::string &subscript, size_t size, size_t &i) {
+  long long n;
+  if (!Arithmetic::evaluate(subscript.data(), subscript.size(), n)) {
+    return false;
+  }
+  if (n < 0) {
+    n += size;
+  }
+  if (n < 0) {
+    return false;
+  }
+  i = n;
+  return true;
+}
+
+
+
+const char *Variables::element(const std::string &name, const std::string &subscript) {
+
+  Array *a = array(name);
+  if (a != NULL && a->associative) {
+    auto found = a->keys.find(subscript);
+    return found != a->keys.end() ? found->second.c_str() : NULL;
+  }
+
+  size_t i;
+  if (a == NULL) {
+    return index(subscript, 1, i) && i == 0 ? get(name.c_str(), name.size()) : NULL;
+  }
+  if (!index(subscript, a->end(), i)) {
+    return NULL;
+  }
+  auto found = a->items.find(i);
+  return found != a->items.end() ? found->second.c_str() : NULL;
+}
+
+
+
+bool Variables::setElement(const std::string &name, const std::string &subscript, const char *value) {
+
+  Array *a = array(name);
+  if (a == NULL) {
+    // v[0]=x on a plain variable keeps its value in [0] (that's what bash does)
+    const char *old = get(name.c_str(), name.size());
+    std::string first = old != NULL ? old : "";
+    a = &makeArray(name, false);
+    if (old != NULL) {
+      a->items[0] = first;
+    }
+  }
+
+  if (a->associative) {
+    a->keys[subscript] = value;
+    return true;
+  }
+
+  size_t i;
+  if (!index(subscript, a->end(), i)) {
+    fprintf(stderr, "%s[%s]: bad array subscript\n", name.c_str(), subscript.c_str());
+    return false;
+  }
+  a->items[i] = value;
+  return true;
+}
+
+
+
+bool Variables::unsetElement(const std::string &name, const std::string &subscript) {
+
+  Array *a = array(name);
+  if (a == NULL) {
+    return false;
+  }
+  if (a->associative) {
+    return a->keys.erase(subscript) > 0;
+  }
+
+  size_t i;
+  return index(subscript, a->end(), i) && a->items.erase(i) > 0;
+}
+
+
+
+bool Variables::special(const char *name, size_t length, std::string &value) {
+
+  if (length != 1) {
+    return false;
+  }
+
+  switch (name[0]) {
+    case '$': value = std::to_string(shell_pid); return true; // pid of the shell
+    case '!': value = std::to_string(last_pid); return true;  // last background pid
+    case '?': value = std::to_string(code); return true;      // exit code of the last command
+    case '_': value = last_arg; return true;                  // last argument of the last command
+  }
+  return false;
+}
+
+
+
+char **Variables::envp() {
+
+  if (_envpDirty) {
+    _envp.clear();
+    for (auto & v : _table) {
+      if (v.text != NULL && v.text != deleted && v.exported) {
+        _envp.push_back(v.text);
+      }
+    }
+    _envp.push_back(NULL);
+    _envpDirty = false;
+  }
+  return _envp.data();
+}
+
+
+
+void Variables::list(std::vector<const Variable *> &variables) {
+  for (auto & v : _table) {
+    if (v.text != NULL && v.text != deleted) {
+      variables.push_back(&v);
+    }
+  }
+}
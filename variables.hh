@@ -0,0 +1,100 @@
+#ifndef variables_hh
+#define variables_hh
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+
+/* Shell variables
+ * Open addressing hash table (linear probing) instead of libc's environ,
+ * where every getenv() is a linear scan.
+ * Each variable is stored as one "name=value" string, exported ones are
+ * pointed to directly by the envp array handed to exec. That array is only
+ * rebuilt when an exported variable changes, otherwise every command gets
+ * the same one.
+ * The special parameters ($, !, ?, _) are not in the table, special()
+ * answers them without any lookup.
+ * Arrays live apart, by name. They are never exported (same as bash).
+ */
+
+struct Variables {
+
+  struct Variable {
+    char *text;        // "name=value" (malloc'd), NULL if the slot is empty
+    size_t nameLength;
+    unsigned hash;
+    bool exported;
+  };
+
+  static std::vector<Variable> _table; // size is a power of 2
+  static size_t _count;                // live variables
+  static size_t _used;                 // live + deleted slots (probe chains)
+
+  static std::vector<char *> _envp;    // exported "name=value", NULL terminated
+  static bool _envpDirty;
+
+  // declare -a / declare -A / mapfile
+  // Indexed arrays are sparse like in bash: a[1000000]=x is one element
+  struct Array {
+    bool associative;
+    std::map<size_t, std::string> items;               // indexed, in order
+    std::unordered_map<std::string, std::string> keys; // associative
+
+    // Index after the last element (where a negative index counts from)
+    size_t end() const { return items.empty() ? 0 : items.rbegin()->first + 1; }
+  };
+
+  static std::unordered_map<std::string, Array> _arrays;
+
+  // Import the environment the shell was started with (all exported)
+  static void init();
+
+  // Value of a variable, NULL if not set
+  static const char *get(const char *name, size_t length);
+  static const char *get(const char *name) { return get(name, strlen(name)); }
+
+  // Create or change a variable
+  static void set(const char *name, const char *value, bool exported = true);
+
+  // Returns false if it wasn't set
+  static bool unset(const char *name);
+
+  // Drop every variable (rc snapshot replaces the whole environment)
+  static void clear();
+
+  // NULL if 'name' is not an array
+  static Array *array(const std::string &name);
+
+  // Empty array called 'name', replaces the old array or variable
+  static Array &makeArray(const std::string &name, bool associative);
+
+  // name[subscript], NULL if unset. The subscript of an indexed array is
+  // arithmetic, a plain variable is the same as an array with only [0]
+  static const char *element(const std::string &name, const std::string &subscript);
+
+  // name[subscript]=value, makes an indexed array if 'name' is not one yet.
+  // False if the subscript is bad (printed)
+  static bool setElement(const std::string &name, const std::string &subscript, const char *value);
+  static bool unsetElement(const std::string &name, const std::string &subscript);
+
+  // ${$} ${!} ${?} ${_}: true and the value if 'name' is one of them
+  static bool special(const char *name, size_t length, std::string &value);
+
+  // Environment for exec
+  static char **envp();
+
+  // Every variable, exported or not (rc snapshot)
+  static void list(std::vector<const Variable *> &variables);
+
+private:
+  static size_t slot(const char *name, size_t length, unsigned hash);
+  static bool index(const std::string &subscript, size_t size, size_t &i);
+  static void grow();
+};
+
+#endif
@@ -0,0 +1,624 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <unordered_map>
+
+#include "word.hh"
+#include "variables.hh"
+#include "homeCache.hh"
+#include "glob.hh"
+#include "arith.hh"
+#include "sourceCache.hh"
+
+
+
+// Segments of the word being built, turned into a Word by finishWord()
+struct WordBuilder {
+  std::vector<WordSegment> segments;
+  bool present; // something was typed for it, even "" counts
+};
+
+static void addSegment(WordBuilder &word, const char *text, size_t length, bool quoted, Arena &arena) {
+  word.present = true;
+  if (length == 0) {
+    return;
+  }
+
+  // Glue to the last segment when the quoting is the same
+  if (!word.segments.empty() && word.segments.back().quoted == quoted) {
+    WordSegment &last = word.segments.back();
+    char *joined = (char *) arena.allocate(last.length + length, 1);
+    memcpy(joined, last.text, last.length);
+    memcpy(joined + last.length, text, length);
+    last.text = joined;
+    last.length += length;
+    return;
+  }
+
+  WordSegment segment = { arena.strdup(text, length), length, quoted };
+  word.segments.push_back(segment);
+}
+
+
+
+static bool hasWildcard(const WordSegment &segment) {
+  return memchr(segment.text, '*', segment.length) != NULL ||
+         memchr(segment.text, '?', segment.length) != NULL ||
+         memchr(segment.text, '[', segment.length) != NULL;
+}
+
+
+
+static void finishWord(WordBuilder &word, Arena &arena, std::vector<Word *> &words) {
+
+  if (!word.present) {
+    return;
+  }
+
+  Word *result = arena.create<Word>();
+  result->count = word.segments.size();
+  result->segments = (WordSegment *) arena.allocate(sizeof(WordSegment) * (result->count ? result->count : 1));
+
+  size_t length = 0;
+  bool glob = false;
+  for (size_t i = 0; i < result->count; i++) {
+    result->segments[i] = word.segments[i];
+    length += word.segments[i].length;
+    if (!word.segments[i].quoted && hasWildcard(word.segments[i])) {
+      glob = true;
+    }
+  }
+
+  result->text = (char *) arena.allocate(length + 1, 1);
+  char *p = result->text;
+  for (size_t i = 0; i < result->count; i++) {
+    memcpy(p, result->segments[i].text, result->segments[i].length);
+    p += result->segments[i].length;
+  }
+  *p = '\0';
+
+  // Glob pattern: metachars typed inside quotes are escaped
+  result->pattern = NULL;
+  if (glob) {
+    std::string pattern;
+    for (size_t i = 0; i < result->count; i++) {
+      const WordSegment &segment = result->segments[i];
+      for (size_t k = 0; k < segment.length; k++) {
+        char c = segment.text[k];
+        if (segment.quoted && strchr("*?[]\\", c) != NULL) {
+          pattern += '\\';
+        }
+        pattern += c;
+      }
+    }
+    result->pattern = arena.strdup(pattern);
+  }
+
+  words.push_back(result);
+  word.segments.clear();
+  word.present = false;
+}
+
+
+
+// $((...)) at raw[i]: index of its closing "))", or 'length' if it isn't one
+static size_t arithmeticEnd(const char *raw, size_t length, size_t i) {
+  if (i + 2 >= length || raw[i + 1] != '(' || raw[i + 2] != '(') {
+    return length;
+  }
+  int depth = 0;
+  for (size_t k = i + 3; k + 1 < length; k++) {
+    if (raw[k] == '(') {
+      depth++;
+    }
+    else if (raw[k] == ')') {
+      if (depth == 0) {
+        return raw[k + 1] == ')' ? k : length;
+      }
+      depth--;
+    }
+  }
+  return length;
+}
+
+// Value of the $((...)) at raw[i], false if it failed (printed already)
+static bool arithmetic(const char *raw, size_t i, size_t close, std::string &value) {
+  long long result;
+  bool ok = Arithmetic::evaluate(raw + i + 3, close - i - 3, result);
+  value = std::to_string(result);
+  return ok;
+}
+
+
+
+// Unquoted ${...}: split on IFS, the first and last fields join the text around it
+static void addSplitValue(WordBuilder &word, const char *value, Arena &arena, std::vector<Word *> &words) {
+
+  const char *ifs = Variables::get("IFS");
+  if (ifs == NULL) {
+    ifs = " \t\n";
+  }
+
+  size_t length = strlen(value);
+  size_t i = 0;
+  while (i < length) {
+
+    // IFS whitespace runs count as one separator, other IFS chars each end a field
+    bool separated = false;
+    while (i < length && strchr(ifs, value[i]) != NULL && strchr(" \t\n", value[i]) != NULL) {
+      i++;
+      separated = true;
+    }
+    if (i < length && strchr(ifs, value[i]) != NULL) {
+      i++;
+      separated = true;
+      word.present = true; // a:b with IFS=: --> "a" "b", a::b --> "a" "" "b"
+      while (i < length && strchr(ifs, value[i]) != NULL && strchr(" \t\n", value[i]) != NULL) {
+        i++;
+      }
+    }
+    if (separated) {
+      finishWord(word, arena, words);
+    }
+
+    size_t start = i;
+    while (i < length && strchr(ifs, value[i]) == NULL) {
+      i++;
+    }
+    if (i > start) {
+      addSegment(word, value + start, i - start, false, arena);
+    }
+  }
+}
+
+
+
+// Compiled patterns of ${v#pat} and friends, loops use the same few again and again
+static std::unordered_map<std::string, GlobPattern> patterns;
+
+static const GlobPattern &compiledPattern(const char *text, size_t length) {
+  std::string key(text, length);
+  auto found = patterns.find(key);
+  if (found == patterns.end()) {
+    if (patterns.size() >= 256) {
+      patterns.clear();
+    }
+    found = patterns.emplace(key, GlobPattern(text, length)).first;
+  }
+  return found->second;
+}
+
+
+
+// ${v#pat} and the other operators on one value. 'op' is what follows the
+// name (and subscript), 'set' tells unset from empty for :- and :=
+static void applyOperator(const std::string &name, const std::string *subscript, bool set,
+                          const std::string &value, const char *op, size_t opLength, std::string &result) {
+
+  result.clear();
+
+  if (opLength == 0) {
+    result = value;
+    return;
+  }
+
+  const char *rest = op + 1;
+  size_t restLength = opLength - 1;
+
+  switch (op[0]) {
+
+    case '#': {
+      // ## is the longest prefix
+      bool longest = restLength > 0 && rest[0] == '#';
+      if (longest) {
+        rest++;
+        restLength--;
+      }
+      const GlobPattern &pattern = compiledPattern(rest, restLength);
+      size_t cut = 0;
+      for (size_t k = 0; k <= value.size(); k++) {
+        size_t n = longest ? value.size() - k : k;
+        if (pattern.match(value.data(), n)) {
+          cut = n;
+          break;
+        }
+      }
+      result = value.substr(cut);
+      return;
+    }
+
+    case '%': {
+      // %% is the longest suffix
+      bool longest = restLength > 0 && rest[0] == '%';
+      if (longest) {
+        rest++;
+        restLength--;
+      }
+      const GlobPattern &pattern = compiledPattern(rest, restLength);
+      size_t keep = value.size();
+      for (size_t k = 0; k <= value.size(); k++) {
+        size_t start = longest ? k : value.size() - k;
+        if (pattern.match(value.data() + start, value.size() - start)) {
+          keep = start;
+          break;
+        }
+      }
+      result = value.substr(0, keep);
+      return;
+    }
+
+    case '/': {
+      const char *slash = (const char *) memchr(rest, '/', restLength);
+      size_t patternLength = slash != NULL ? slash - rest : restLength;
+      std::string replacement = slash != NULL ? std::string(slash + 1, rest + restLength) : "";
+      const GlobPattern &pattern = compiledPattern(rest, patternLength);
+
+      // Leftmost start, longest match there
+      for (size_t start = 0; start < value.size(); start++) {
+        for (size_t end = value.size(); end > start; end--) {
+          if (pattern.match(value.data() + start, end - start)) {
+            result = value.substr(0, start) + replacement + value.substr(end);
+            return;
+          }
+        }
+      }
+      result = value;
+      return;
+    }
+
+    case ':': {
+      if (restLength > 0 && (rest[0] == '-' || rest[0] == '=')) {
+        if (set && !value.empty()) {
+          result = value;
+          return;
+        }
+        result.assign(rest + 1, restLength - 1);
+        if (rest[0] == '=') {
+          if (subscript != NULL) {
+            Variables::setElement(name, *subscript, result.c_str());
+          }
+          else {
+            Variables::set(name.c_str(), result.c_str(), false);
+          }
+        }
+        return;
+      }
+
+      // Substring. A word can't have a space, so a negative offset is
+      // written ${v:(-2)} (${v:-2} would be a default)
+      std::string numbers(rest, restLength);
+      const char *start = numbers.c_str();
+      if (*start == '(') {
+        start++;
+      }
+      char *end;
+      long offset = strtol(start, &end, 10);
+      if (*end == ')') {
+        end++;
+      }
+      long size = value.size();
+      if (offset < 0) {
+        offset = offset + size < 0 ? 0 : offset + size;
+      }
+      if (offset > size) {
+        offset = size;
+      }
+      long count = size - offset;
+      if (*end == ':') {
+        count = strtol(end + 1, NULL, 10);
+        if (count < 0) {
+          // Negative length: stop that many chars before the end
+          count = size + count - offset;
+          if (count < 0) {
+            count = 0;
+          }
+        }
+      }
+      result = value.substr(offset, count);
+      return;
+    }
+  }
+
+  // Anything else is not an operator we know: plain value
+  result = value;
+}
+
+
+
+
+
+
+/* ${...}, 'expr' is what is between the braces
+ *   ${v}                      value of v (or special parameter $ ! ? _)
+ *   ${#v}                     length
+ *   ${v#pat}  ${v##pat}       remove shortest/longest matching prefix
+ *   ${v%pat}  ${v%%pat}       remove shortest/longest matching suffix
+ *   ${v/pat/rep}              replace the first (longest) match
+ *   ${v:off}  ${v:off:len}    substring, ${v:(-off)} counts from the end
+ *   ${v:-word}  ${v:=word}    word if v is unset or empty (:= also sets v)
+ *   ${a[i]}  ${a[@]}          array element, all elements (operators work on each)
+ *   ${#a[@]}  ${!a[@]}        number of elements, the indexes/keys
+ * All done here, no sed/cut/basename process needed.
+ * Returns true for [@] and [*]: "${a[@]}" makes one word per value.
+ */
+static bool parameter(const char *expr, size_t length, std::vector<std::string> &values) {
+
+  values.clear();
+
+  bool wantLength = length > 1 && expr[0] == '#';
+  bool wantKeys = length > 1 && expr[0] == '!' && memchr(expr, '[', length) != NULL;
+  if (wantLength || wantKeys) {
+    expr++;
+    length--;
+  }
+
+  // Name: one special char or letters, digits and _
+  size_t nameLength = 0;
+  while (nameLength < length && (isalnum((unsigned char) expr[nameLength]) || expr[nameLength] == '_')) {
+    nameLength++;
+  }
+  if (nameLength == 0 && length > 0) {
+    nameLength = 1;
+  }
+
+  std::string name(expr, nameLength);
+  const char *op = expr + nameLength;
+  size_t opLength = length - nameLength;
+
+  // [subscript]
+  std::string subscript;
+  bool subscripted = false;
+  if (opLength > 0 && op[0] == '[' && memchr(op, ']', opLength) != NULL) {
+    const char *close = (const char *) memchr(op, ']', opLength);
+    subscript.assign(op + 1, close - op - 1);
+    subscripted = true;
+    opLength -= close + 1 - op;
+    op = close + 1;
+  }
+
+  std::string result;
+
+  if (subscripted && (subscript == "@" || subscript == "*")) {
+    // All of them. A plain variable is an array of one
+    Variables::Array *array = Variables::array(name);
+    if (array == NULL) {
+      const char *v = Variables::get(name.c_str(), name.size());
+      if (v != NULL) {
+        values.push_back(wantKeys ? "0" : v);
+      }
+    }
+    else if (array->associative) {
+      for (auto & item : array->keys) {
+        values.push_back(wantKeys ? item.first : item.second);
+      }
+    }
+    else {
+      for (auto & item : array->items) {
+        values.push_back(wantKeys ? std::to_string(item.first) : item.second);
+      }
+    }
+
+    if (wantLength) {
+      values.assign(1, std::to_string(values.size()));
+      return false;
+    }
+    if (!wantKeys) {
+      for (auto & value : values) {
+        applyOperator(name, NULL, true, value, op, opLength, result);
+        value = result;
+      }
+    }
+    return true;
+  }
+
+  std::string value;
+  bool set = true;
+  if (subscripted || Variables::array(name) != NULL) {
+    // ${a} is ${a[0]}
+    const char *v = Variables::element(name, subscripted ? subscript : "0");
+    set = v != NULL;
+    value = set ? v : "";
+  }
+  else if (!Variables::special(name.c_str(), name.size(), value)) {
+    const char *v = Variables::get(name.c_str(), name.size());
+    set = v != NULL;
+    value = set ? v : "";
+  }
+
+  if (wantLength) {
+    values.push_back(std::to_string(value.size()));
+    return false;
+  }
+
+  applyOperator(name, subscripted ? &subscript : NULL, set, value, op, opLength, result);
+  values.push_back(result);
+  return false;
+}
+
+
+
+bool expandWord(const char *raw, size_t length, Arena &arena, std::vector<Word *> &words) {
+
+  WordBuilder word;
+  word.present = false;
+  size_t i = 0;
+  size_t arithClose; // "))" of a $((...))
+  bool ok = true;    // no $((...)) failed
+
+  // ~ and ~user, up to the first /
+  if (length > 0 && raw[0] == '~') {
+
+    // Result depends on when it runs, don't cache a sourced file using it
+    SourceCache::_uncacheable = true;
+
+    size_t end = 1;
+    while (end < length && raw[end] != '/' && strchr("\"'\\$", raw[end]) == NULL) {
+      end++;
+    }
+    if (end == length || raw[end] == '/') {
+      const char *home;
+      if (end == 1) {
+        home = Variables::get("HOME");
+      }
+      else {
+        // ~user, through the passwd cache
+        home = HomeCache::lookup(std::string(raw + 1, end - 1));
+      }
+
+      // No such user (or no HOME): the ~ stays as typed
+      if (home != NULL) {
+        addSegment(word, home, strlen(home), true, arena);
+        i = end;
+      }
+    }
+  }
+
+  while (i < length) {
+
+    char c = raw[i];
+
+    if (c == '\'') {
+      // Single quotes: everything literal
+      size_t end = i + 1;
+      while (end < length && raw[end] != '\'') {
+        end++;
+      }
+      addSegment(word, raw + i + 1, end - i - 1, true, arena);
+      i = end + 1;
+    }
+    else if (c == '"') {
+      // Double quotes: ${...} and \" \\ \$ still work, nothing is split or globbed
+      i++;
+      word.present = true;
+      size_t start = i;
+      while (i < length && raw[i] != '"') {
+        if (raw[i] == '\\' && i + 1 < length && strchr("\"\\$`", raw[i + 1]) != NULL) {
+          addSegment(word, raw + start, i - start, true, arena);
+          addSegment(word, raw + i + 1, 1, true, arena);
+          i += 2;
+          start = i;
+        }
+        else if (raw[i] == '$' && (arithClose = arithmeticEnd(raw, length, i)) < length) {
+          addSegment(word, raw + start, i - start, true, arena);
+
+          SourceCache::_uncacheable = true;
+          std::string value;
+          ok = arithmetic(raw, i, arithClose, value) && ok;
+          addSegment(word, value.data(), value.size(), true, arena);
+          i = arithClose + 2;
+          start = i;
+        }
+        else if (raw[i] == '$' && i + 1 < length && raw[i + 1] == '{') {
+          size_t close = i + 2;
+          while (close < length && raw[close] != '}' && raw[close] != '"') {
+            close++;
+          }
+          if (close == length || raw[close] != '}') {
+            i++;
+            continue;
+          }
+          addSegment(word, raw + start, i - start, true, arena);
+
+          SourceCache::_uncacheable = true;
+          std::vector<std::string> values;
+          bool all = parameter(raw + i + 2, close - i - 2, values);
+          for (size_t k = 0; k < values.size(); k++) {
+            if (all && k > 0) {
+              // "${a[@]}": every element its own word
+              finishWord(word, arena, words);
+            }
+            addSegment(word, values[k].data(), values[k].size(), true, arena);
+          }
+          i = close + 1;
+          start = i;
+        }
+        else {
+          i++;
+        }
+      }
+      addSegment(word, raw + start, i - start, true, arena);
+      i++;
+    }
+    else if (c == '\\') {
+      // Backslash: next char as is
+      if (i + 1 < length) {
+        addSegment(word, raw + i + 1, 1, true, arena);
+        i += 2;
+      }
+      else {
+        addSegment(word, raw + i, 1, true, arena);
+        i++;
+      }
+    }
+    else if (c == '$' && (arithClose = arithmeticEnd(raw, length, i)) < length) {
+      // $((...)), a number: nothing to split or glob
+      SourceCache::_uncacheable = true;
+      std::string value;
+      ok = arithmetic(raw, i, arithClose, value) && ok;
+      addSegment(word, value.data(), value.size(), false, arena);
+      i = arithClose + 2;
+    }
+    else if (c == '$' && i + 1 < length && raw[i + 1] == '{' && memchr(raw + i, '}', length - i) != NULL) {
+      // ${name}, split unless quoted
+      size_t close = (const char *) memchr(raw + i, '}', length - i) - raw;
+
+      SourceCache::_uncacheable = true;
+      std::vector<std::string> values;
+      parameter(raw + i + 2, close - i - 2, values);
+
+      // ${a[@]}: like bash the elements are joined with the first IFS char
+      // and the whole is split (IFS=: keeps an empty element as a field).
+      // An empty IFS splits nothing, each non-empty element is a field
+      const char *ifs = Variables::get("IFS");
+      if (ifs != NULL && *ifs == '\0') {
+        bool first = true;
+        for (auto & value : values) {
+          if (!value.empty()) {
+            if (!first) {
+              finishWord(word, arena, words);
+            }
+            addSegment(word, value.data(), value.size(), false, arena);
+            first = false;
+          }
+        }
+      }
+      else {
+        std::string value;
+        for (size_t k = 0; k < values.size(); k++) {
+          if (k > 0) {
+            value += ifs != NULL ? ifs[0] : ' ';
+          }
+          value += values[k];
+        }
+        addSplitValue(word, value.c_str(), arena, words);
+      }
+      i = close + 1;
+    }
+    else {
+      // Plain text up to the next quote, backslash or $
+      size_t start = i++;
+      while (i < length && strchr("'\"\\$", raw[i]) == NULL) {
+        i++;
+      }
+      addSegment(word, raw + start, i - start, false, arena);
+    }
+  }
+
+  finishWord(word, arena, words);
+  return ok;
+}
+
+
+
+Word *literalWord(const char *text, size_t length, bool quoted, Arena &arena) {
+
+  WordBuilder word;
+  word.present = false;
+  addSegment(word, text, length, quoted, arena);
+
+  std::vector<Word *> words;
+  finishWord(word, arena, words);
+  return words[0];
+}
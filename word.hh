@@ -0,0 +1,42 @@
+#ifndef word_hh
+#define word_hh
+
+#include <cstddef>
+#include <vector>
+
+#include "arena.hh"
+
+
+
+/* Words and their expansion
+ * The lexer hands over a word exactly as it was typed (quotes, backslashes,
+ * ${...}, ~) and expandWord() does all the expansions in one pass over it:
+ * tilde, parameters, $((...)), quote and escape removal, field splitting.
+ * The result keeps which parts were quoted, so the parser only globs a word
+ * when an unquoted part has a * or ?: "*.log" is never a directory scan.
+ * $(...) output is split by the lexer itself and comes in as unquoted words.
+ */
+
+// One piece of a word after expansion
+struct WordSegment {
+  const char *text;
+  size_t length;
+  bool quoted; // from '...', "...", a backslash or ~: never globbed or split
+};
+
+struct Word {
+  WordSegment *segments;
+  size_t count;
+  char *text;    // all segments joined, what the argument is without globbing
+  char *pattern; // same with quoted * ? [ ] \ escaped, NULL if nothing to glob
+};
+
+// Expand 'raw' into 0 or more words (unquoted ${...} can split into several
+// or vanish). Everything is allocated in 'arena'. False if a $((...)) failed
+// (division by zero...), the error is already printed.
+bool expandWord(const char *raw, size_t length, Arena &arena, std::vector<Word *> &words);
+
+// A word that is used as is (file names the lexer made up...)
+Word *literalWord(const char *text, size_t length, bool quoted, Arena &arena);
+
+#endif